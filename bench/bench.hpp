@@ -0,0 +1,50 @@
+#ifndef MTP_BENCH_HPP
+#define MTP_BENCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+namespace bench {
+
+template <typename T>
+inline auto
+do_not_optimize(T const& value) -> void
+{
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static_cast<void>(*static_cast<T const volatile*>(&value));
+#endif
+}
+
+inline auto
+clobber() -> void
+{
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : : "memory");
+#endif
+}
+
+// Runs `f` `iters` times and returns the mean wall time per call in nanoseconds.
+template <typename F>
+auto
+time_ns(std::size_t iters, F&& f) -> double
+{
+  auto const start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < iters; ++i) {
+    f();
+  }
+  auto const stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(iters);
+}
+
+inline auto
+report(char const* name, double ns, double items_per_call = 1.0) -> void
+{
+  std::printf("%-48s %12.2f ns/op %12.2f M items/s\n", name, ns, items_per_call * 1e3 / ns);
+}
+
+} // namespace bench
+
+#endif // MTP_BENCH_HPP
@@ -0,0 +1,45 @@
+// Instantiates the runtime paths of `basic_fixed_string` for MTP_CODE_SIZE_COUNT distinct lengths.
+// Built by code_size.sh, which reports the resulting .text size.
+
+#include <cstddef>
+#include <iostream>
+#include <new>
+#include <utility>
+
+#include <mtp/fixed_string.hpp>
+
+#ifndef MTP_CODE_SIZE_COUNT
+#  define MTP_CODE_SIZE_COUNT 64
+#endif
+
+namespace {
+
+// `basic_fixed_string` is an implicit-lifetime type; reuse one zeroed buffer for every length so
+// only the operations under test are instantiated per `N`.
+alignas(16) char storage[2][MTP_CODE_SIZE_COUNT + 16 + 1];
+
+template <std::size_t N>
+[[gnu::noinline]] auto
+exercise(std::ostream& os) -> int
+{
+  auto& a = *std::launder(reinterpret_cast<mtp::fixed_string<N>*>(storage[0]));
+  auto& b = *std::launder(reinterpret_cast<mtp::fixed_string<N>*>(storage[1]));
+  a.swap(b);
+  os << a;
+  return (a == b) + ((a <=> b) < 0);
+}
+
+template <std::size_t... Is>
+auto
+exercise_all(std::ostream& os, std::index_sequence<Is...>) -> int
+{
+  return (0 + ... + exercise<Is + 16>(os));
+}
+
+} // namespace
+
+auto
+main() -> int
+{
+  return exercise_all(std::cout, std::make_index_sequence<MTP_CODE_SIZE_COUNT>{});
+}
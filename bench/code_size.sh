@@ -0,0 +1,21 @@
+#!/bin/sh
+# Reports .text bytes of bench/code_size.cpp as the number of distinct `N` grows.
+# usage: bench/code_size.sh [CXX] [CXXFLAGS...]
+
+set -eu
+
+here=$(cd "$(dirname "$0")" && pwd)
+cxx=${1:-${CXX:-c++}}
+[ $# -gt 0 ] && shift
+flags=${*:-"-O2"}
+out=$(mktemp -d)
+trap 'rm -rf "$out"' EXIT
+
+printf '%8s %12s\n' "N count" ".text bytes"
+for count in 1 16 64 256; do
+  # shellcheck disable=SC2086
+  "$cxx" -std=c++20 $flags -I"$here/../include" -DMTP_CODE_SIZE_COUNT="$count" \
+    "$here/code_size.cpp" -o "$out/code_size_$count"
+  text=$(size -A "$out/code_size_$count" | awk '$1 == ".text" { print $2 }')
+  printf '%8s %12s\n' "$count" "$text"
+done
@@ -0,0 +1,112 @@
+#include "bench.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+#ifdef MTP_BUILD_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/compressed.hpp>
+#endif
+
+namespace {
+
+using mtp::basic_fixed_string;
+using mtp::compressed;
+
+// Typical rarely-read constant payloads: CLI help text and a JSON schema.
+constexpr auto help_text = basic_fixed_string{
+  "Usage: ingest [OPTION]... [FILE]...\n"
+  "Read market data records from FILE(s) (or standard input) and publish them.\n"
+  "\n"
+  "Options:\n"
+  "  -c, --config=FILE          read configuration from FILE (default: /etc/ingest.conf)\n"
+  "  -t, --threads=NUM          number of worker threads (default: number of cores)\n"
+  "  -b, --batch-size=NUM       number of records per batch (default: 4096)\n"
+  "  -q, --queue-depth=NUM      depth of the publish queue (default: 65536)\n"
+  "  -o, --output=URI           publish records to URI (default: tcp://localhost:9000)\n"
+  "  -f, --format=FORMAT        input format: csv, fix, itch, ouch (default: csv)\n"
+  "  -s, --symbols=FILE         only publish records for symbols listed in FILE\n"
+  "  -v, --verbose              print diagnostics to standard error\n"
+  "      --log-file=FILE        write diagnostics to FILE instead of standard error\n"
+  "      --log-level=LEVEL      diagnostics level: trace, debug, info, warn, error\n"
+  "      --metrics=URI          export metrics to URI (default: disabled)\n"
+  "      --metrics-interval=MS  metrics export interval in milliseconds (default: 1000)\n"
+  "      --dry-run              parse records but do not publish them\n"
+  "      --help                 display this help and exit\n"
+  "      --version              output version information and exit\n"
+  "\n"
+  "Exit status:\n"
+  "  0  if OK,\n"
+  "  1  if minor problems (e.g., a record could not be parsed),\n"
+  "  2  if serious trouble (e.g., the output URI could not be reached).\n"
+  "\n"
+  "Examples:\n"
+  "  ingest --format=itch --threads=4 feed.itch\n"
+  "  ingest --format=csv --symbols=sp500.txt --output=tcp://publisher:9000 trades.csv\n"
+  "  ingest --format=fix --dry-run --verbose session.log\n"
+  "\n"
+  "Report bugs to the market data team. Full documentation is available in the handbook.\n"
+};
+
+constexpr auto json_schema = basic_fixed_string{
+  R"({"$schema":"https://json-schema.org/draft/2020-12/schema","title":"Order","type":"object",)"
+  R"("properties":{"order_id":{"type":"string","description":"Unique order identifier"},)"
+  R"("client_order_id":{"type":"string","description":"Client supplied order identifier"},)"
+  R"("symbol":{"type":"string","description":"Instrument symbol","maxLength":8},)"
+  R"("side":{"type":"string","enum":["buy","sell","sell_short","sell_short_exempt"]},)"
+  R"("order_type":{"type":"string","enum":["market","limit","stop","stop_limit"]},)"
+  R"("time_in_force":{"type":"string","enum":["day","gtc","ioc","fok","gtd"]},)"
+  R"("quantity":{"type":"integer","description":"Order quantity","minimum":1},)"
+  R"("filled_quantity":{"type":"integer","description":"Filled quantity","minimum":0},)"
+  R"("limit_price":{"type":"number","description":"Limit price","minimum":0},)"
+  R"("stop_price":{"type":"number","description":"Stop price","minimum":0},)"
+  R"("created_at":{"type":"string","format":"date-time","description":"Creation time"},)"
+  R"("updated_at":{"type":"string","format":"date-time","description":"Last update time"}},)"
+  R"("required":["order_id","symbol","side","order_type","quantity"]})"
+};
+
+template <basic_fixed_string Str>
+auto
+run(char const* name) -> void
+{
+  using c = compressed<Str>;
+
+  auto const start = std::chrono::steady_clock::now();
+  auto const* p = c::c_str();
+  auto const stop = std::chrono::steady_clock::now();
+  bench::do_not_optimize(p);
+
+  std::printf("%s: %zu bytes -> %zu bytes (%.1f%%), first access %.2f us\n", name,
+              c::size() * sizeof(typename c::value_type), c::compressed_size(),
+              100.0 * static_cast<double>(c::compressed_size()) /
+                  static_cast<double>(c::size() * sizeof(typename c::value_type)),
+              std::chrono::duration<double, std::micro>(stop - start).count());
+
+  bench::report("  cached view()", bench::time_ns(1'000'000, [] {
+                  auto v = c::view();
+                  bench::do_not_optimize(v);
+                }));
+  bench::report(
+      "  stream() full pass (per char)",
+      bench::time_ns(1'000,
+                     [] {
+                       std::size_t sum = 0;
+                       for (auto ch : c::stream()) {
+                         sum += static_cast<std::size_t>(ch);
+                       }
+                       bench::do_not_optimize(sum);
+                     }) /
+          static_cast<double>(c::size()),
+      1.0);
+}
+
+} // namespace
+
+auto
+main() -> int
+{
+  run<help_text>("help text");
+  run<json_schema>("json schema");
+  return 0;
+}
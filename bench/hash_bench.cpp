@@ -0,0 +1,87 @@
+#include "bench.hpp"
+#include "random_keys.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#ifdef MTP_BUILD_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/hash.hpp>
+#endif
+
+namespace {
+
+constexpr std::size_t key_count = 4096;
+constexpr std::size_t iters = 500;
+
+template <std::size_t N>
+auto
+make_keys(std::size_t n) -> std::vector<mtp::fixed_string<N>>
+{
+  return random_keys::make<mtp::fixed_string<N>>(n, [](std::uint64_t x) { return 'a' + x % 26; });
+}
+
+template <std::size_t N>
+auto
+run() -> void
+{
+  auto const keys = make_keys<N>(key_count);
+  std::vector<std::uint64_t> out(key_count);
+  auto const per_key = static_cast<double>(key_count);
+
+  auto const std_hash = bench::time_ns(iters, [&] {
+    for (std::size_t i = 0; i < key_count; ++i) {
+      out[i] = std::hash<std::string_view>{}(keys[i].view());
+    }
+    bench::clobber();
+  });
+  auto const one = bench::time_ns(iters, [&] {
+    for (std::size_t i = 0; i < key_count; ++i) {
+      out[i] = mtp::hash_one(keys[i]);
+    }
+    bench::clobber();
+  });
+  auto const many = bench::time_ns(iters, [&] {
+    mtp::hash_many(std::span{ keys }, std::span{ out });
+    bench::clobber();
+  });
+  std::printf("%2zu chars: std::hash %6.2f ns/key, hash_one %6.2f ns/key, hash_many %6.2f ns/key\n",
+              N, std_hash / per_key, one / per_key, many / per_key);
+}
+
+auto
+run_threaded() -> void
+{
+  constexpr std::size_t n = std::size_t{ 1 } << 22;
+  auto const keys = make_keys<16>(n);
+  std::vector<std::uint64_t> out(n);
+  for (auto threads : { 1u, 2u, 4u, 0u }) {
+    auto const ns = bench::time_ns(10, [&] {
+      mtp::hash_many(std::span{ keys }, std::span{ out }, threads);
+      bench::clobber();
+    });
+    std::printf("16 chars, %zu keys, threads=%u: %6.2f ns/key\n", n, threads,
+                ns / static_cast<double>(n));
+  }
+}
+
+} // namespace
+
+auto
+main() -> int
+{
+  run<4>();
+  run<8>();
+  run<16>();
+  run<24>();
+  run<32>();
+  run<64>();
+  run_threaded();
+  return 0;
+}
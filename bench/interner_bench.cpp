@@ -0,0 +1,86 @@
+#include "bench.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#ifdef MTP_BUILD_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/interner.hpp>
+#endif
+
+namespace {
+
+constexpr std::size_t symbol_count = 50'000;
+constexpr std::size_t ops_per_thread = 200'000;
+
+// Baseline: the mutex-protected set the interner replaces.
+class mutex_interner
+{
+  std::mutex _mutex;
+  std::unordered_set<std::string> _set;
+
+public:
+  auto
+  intern(std::string_view str) -> std::string const*
+  {
+    auto lock = std::lock_guard{ _mutex };
+    return &*_set.emplace(str).first;
+  }
+};
+
+template <typename Interner>
+auto
+run(unsigned threads, std::vector<std::string> const& symbols) -> double
+{
+  Interner in;
+  std::atomic<bool> go{ false };
+  std::vector<std::thread> pool;
+  for (auto t = 0u; t < threads; ++t) {
+    pool.emplace_back([&, t] {
+      while (!go.load(std::memory_order_acquire)) {
+      }
+      // mostly hits after warm-up, as on the ingest path
+      auto idx = static_cast<std::size_t>(t) * 7919;
+      for (std::size_t i = 0; i < ops_per_thread; ++i) {
+        idx = (idx * 1103515245 + 12345) % symbols.size();
+        auto h = in.intern(symbols[idx]);
+        bench::do_not_optimize(h);
+      }
+    });
+  }
+  auto const start = std::chrono::steady_clock::now();
+  go.store(true, std::memory_order_release);
+  for (auto& th : pool) {
+    th.join();
+  }
+  auto const stop = std::chrono::steady_clock::now();
+  auto const secs = std::chrono::duration<double>(stop - start).count();
+  return static_cast<double>(threads * ops_per_thread) / secs / 1e6;
+}
+
+} // namespace
+
+auto
+main() -> int
+{
+  std::vector<std::string> symbols;
+  for (std::size_t i = 0; i < symbol_count; ++i) {
+    symbols.push_back("SYM." + std::to_string(i * 2654435761u % 1'000'000'007u));
+  }
+
+  std::printf("%8s %20s %20s\n", "threads", "mtp::interner Mops/s", "mutex+set Mops/s");
+  for (auto threads : { 1u, 2u, 4u, 8u, 16u, 32u, 64u }) {
+    auto const a = run<mtp::interner>(threads, symbols);
+    auto const b = run<mutex_interner>(threads, symbols);
+    std::printf("%8u %20.2f %20.2f\n", threads, a, b);
+  }
+  return 0;
+}
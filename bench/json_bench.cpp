@@ -0,0 +1,218 @@
+#include "bench.hpp"
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef MTP_BUILD_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/json.hpp>
+#endif
+
+namespace {
+
+constexpr std::size_t record_count = 1024;
+constexpr std::size_t iters = 200;
+
+struct order
+{
+  std::uint64_t id;
+  std::string symbol;
+  double price;
+  std::uint32_t qty;
+  bool buy;
+  std::string note;
+};
+
+// A typical schema-agnostic writer: every key and string is escaped byte by byte at runtime.
+class generic_writer
+{
+  std::string _buf;
+  bool _comma = false;
+
+  auto
+  separate() -> void
+  {
+    if (_comma) {
+      _buf.push_back(',');
+    }
+    _comma = true;
+  }
+
+  auto
+  string(std::string_view str) -> void
+  {
+    _buf.push_back('"');
+    for (auto c : str) {
+      switch (c) {
+        case '"': _buf += "\\\""; break;
+        case '\\': _buf += "\\\\"; break;
+        case '\n': _buf += "\\n"; break;
+        case '\r': _buf += "\\r"; break;
+        case '\t': _buf += "\\t"; break;
+        case '\b': _buf += "\\b"; break;
+        case '\f': _buf += "\\f"; break;
+        default:
+          if (static_cast<unsigned char>(c) < 0x20) {
+            char tmp[8];
+            std::snprintf(tmp, sizeof(tmp), "\\u%04x", static_cast<unsigned>(c));
+            _buf += tmp;
+          } else {
+            _buf.push_back(c);
+          }
+      }
+    }
+    _buf.push_back('"');
+  }
+
+public:
+  auto
+  clear() -> void
+  {
+    _buf.clear();
+    _comma = false;
+  }
+
+  auto
+  size() const -> std::size_t
+  {
+    return _buf.size();
+  }
+
+  auto
+  begin_object() -> void
+  {
+    separate();
+    _buf.push_back('{');
+    _comma = false;
+  }
+
+  auto
+  end_object() -> void
+  {
+    _buf.push_back('}');
+    _comma = true;
+  }
+
+  auto
+  key(std::string_view name) -> void
+  {
+    separate();
+    string(name);
+    _buf.push_back(':');
+    _comma = false;
+  }
+
+  auto
+  value(std::string_view str) -> void
+  {
+    separate();
+    string(str);
+  }
+
+  template <typename T>
+  auto
+  number(T v) -> void
+  {
+    separate();
+    char tmp[32];
+    _buf.append(tmp, std::to_chars(tmp, tmp + sizeof(tmp), v).ptr);
+  }
+
+  auto
+  boolean(bool b) -> void
+  {
+    separate();
+    _buf += b ? "true" : "false";
+  }
+};
+
+auto
+make_orders(std::size_t note_size) -> std::vector<order>
+{
+  std::vector<order> orders;
+  std::uint64_t x = 88172645463325252u;
+  for (std::size_t i = 0; i < record_count; ++i) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    auto note = std::string(note_size, 'n');
+    if (note_size > 0 && x % 4 == 0) {
+      note[x % note_size] = '"'; // an occasional character that needs escaping
+    }
+    orders.push_back({ x % 1000000, "SYM" + std::to_string(x % 100),
+                       static_cast<double>(x % 100000) / 100, static_cast<std::uint32_t>(x % 5000),
+                       (x & 1) != 0, std::move(note) });
+  }
+  return orders;
+}
+
+auto
+run(std::size_t note_size) -> void
+{
+  auto const orders = make_orders(note_size);
+
+  generic_writer g;
+  std::size_t bytes = 0;
+  auto const generic_ns = bench::time_ns(iters, [&] {
+    g.clear();
+    for (auto const& o : orders) {
+      g.begin_object();
+      g.key("order_id");
+      g.number(o.id);
+      g.key("symbol");
+      g.value(o.symbol);
+      g.key("limit_price");
+      g.number(o.price);
+      g.key("quantity");
+      g.number(o.qty);
+      g.key("side");
+      g.value(o.buy ? "buy" : "sell");
+      g.key("is_marketable");
+      g.boolean(o.buy);
+      g.key("client_note");
+      g.value(o.note);
+      g.end_object();
+    }
+    bytes = g.size();
+  });
+
+  mtp::json::writer w;
+  auto const mtp_ns = bench::time_ns(iters, [&] {
+    w.clear();
+    for (auto const& o : orders) {
+      w.begin_object()
+        .member<"order_id">(o.id)
+        .member<"symbol">(std::string_view{ o.symbol })
+        .member<"limit_price">(o.price)
+        .member<"quantity">(o.qty)
+        .key<"side">();
+      o.buy ? w.value<"buy">() : w.value<"sell">();
+      w.member<"is_marketable">(o.buy)
+        .member<"client_note">(std::string_view{ o.note })
+        .end_object();
+    }
+    bench::do_not_optimize(w.size());
+  });
+
+  auto const mb = static_cast<double>(bytes) / 1e6;
+  std::printf("note %4zu bytes: generic %7.1f MB/s, mtp::json::writer %7.1f MB/s\n", note_size,
+              mb / (generic_ns * 1e-9), mb / (mtp_ns * 1e-9));
+}
+
+} // namespace
+
+auto
+main() -> int
+{
+  run(0);
+  run(16);
+  run(64);
+  run(256);
+  return 0;
+}
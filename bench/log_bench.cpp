@@ -0,0 +1,115 @@
+#include "bench.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string_view>
+#include <vector>
+#include <version>
+
+#ifdef __cpp_lib_format
+#  include <format>
+#endif
+#if defined(__x86_64__) || defined(_M_X64)
+#  include <x86intrin.h>
+#endif
+
+#ifdef MTP_BUILD_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/log.hpp>
+#endif
+
+namespace {
+
+constexpr std::size_t calls = 200000;
+
+auto
+ticks() noexcept -> std::uint64_t
+{
+#if defined(__x86_64__) || defined(_M_X64)
+  return __rdtsc();
+#else
+  return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+auto
+ns_per_tick() -> double
+{
+  auto const t0 = ticks();
+  auto const c0 = std::chrono::steady_clock::now();
+  while (std::chrono::steady_clock::now() - c0 < std::chrono::milliseconds{ 50 }) {}
+  auto const t1 = ticks();
+  auto const c1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(c1 - c0).count() / static_cast<double>(t1 - t0);
+}
+
+// times every call of `f(i)` individually and prints latency percentiles
+template <typename F>
+auto
+percentiles(char const* name, double scale, F&& f) -> void
+{
+  std::vector<std::uint64_t> samples(calls);
+  for (std::size_t i = 0; i < calls; ++i) {
+    auto const t0 = ticks();
+    f(i);
+    auto const t1 = ticks();
+    samples[i] = t1 - t0;
+  }
+  std::sort(samples.begin(), samples.end());
+  auto const at = [&](double q) {
+    return static_cast<double>(samples[static_cast<std::size_t>(q * (calls - 1))]) * scale;
+  };
+  std::printf("%-28s p50 %8.1f ns  p90 %8.1f ns  p99 %8.1f ns  p99.9 %8.1f ns  max %9.1f ns\n",
+              name, at(0.5), at(0.9), at(0.99), at(0.999), at(1.0));
+}
+
+} // namespace
+
+auto
+main() -> int
+{
+  auto const scale = ns_per_tick();
+  auto* sink = std::fopen("/dev/null", "wb");
+  if (sink == nullptr) {
+    return 1;
+  }
+  auto& backend = mtp::log_backend::instance();
+  backend.set_ring_capacity(std::size_t{ 32 } << 20); // holds every record of a run
+  std::string_view const symbol = "AAPL";
+
+  percentiles("timer only", scale, [](std::size_t i) { bench::do_not_optimize(i); });
+
+  for (auto round = 0; round < 2; ++round) { // the first round also pays for page faults
+    percentiles("mtp::log", scale, [&](std::size_t i) {
+      mtp::log<"order {} {} filled at {}">(i, symbol, 187.25 + static_cast<double>(i % 100));
+    });
+    backend.poll(sink);
+  }
+
+  char line[128];
+  percentiles(
+#ifdef __cpp_lib_format
+    "std::format_to_n + fwrite",
+#else
+    "snprintf + fwrite",
+#endif
+    scale, [&](std::size_t i) {
+      auto const px = 187.25 + static_cast<double>(i % 100);
+#ifdef __cpp_lib_format
+      auto const n =
+        std::format_to_n(line, sizeof(line), "order {} {} filled at {}\n", i, symbol, px).size;
+#else
+      auto const n = std::snprintf(line, sizeof(line), "order %zu %.*s filled at %g\n", i,
+                                   static_cast<int>(symbol.size()), symbol.data(), px);
+#endif
+      std::fwrite(line, 1, static_cast<std::size_t>(n), sink);
+    });
+
+  std::printf("dropped records: %llu\n", static_cast<unsigned long long>(backend.dropped()));
+  std::fclose(sink);
+  return 0;
+}
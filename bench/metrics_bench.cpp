@@ -0,0 +1,94 @@
+#include "bench.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifdef MTP_BUILD_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/metrics.hpp>
+#endif
+
+namespace {
+
+// the usual alternatives: one contended atomic, or a locked map looked up by name
+std::atomic<std::uint64_t> shared_counter{ 0 };
+
+struct locked_map
+{
+  std::mutex mutex;
+  std::unordered_map<std::string, std::uint64_t> values;
+
+  auto
+  add(std::string_view name, std::uint64_t n) -> void
+  {
+    auto lock = std::lock_guard{ mutex };
+    values[std::string{ name }] += n;
+  }
+} named_counters;
+
+// runs `f(i)` `ops` times on each of `threads` threads and returns the mean per-call wall time
+// seen by each thread; with more threads than cores this includes time spent descheduled
+template <typename F>
+auto
+per_op_ns(unsigned threads, std::size_t ops, F const& f) -> double
+{
+  std::vector<double> ns(threads);
+  std::vector<std::thread> workers;
+  for (auto t = 0u; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      ns[t] = bench::time_ns(ops, [&, i = std::size_t{ 0 }]() mutable { f(i++); });
+    });
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+  auto sum = 0.0;
+  for (auto v : ns) {
+    sum += v;
+  }
+  return sum / threads;
+}
+
+} // namespace
+
+auto
+main() -> int
+{
+  std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+  std::printf("%8s %16s %16s %16s %16s\n", "threads", "mtp::counter", "shared atomic",
+              "locked map", "mtp::histogram");
+  for (auto threads : { 1u, 2u, 4u, 8u, 16u, 32u, 64u }) {
+    constexpr std::size_t ops = 1u << 20;
+    auto const counter =
+      per_op_ns(threads, ops, [](std::size_t) { mtp::counter<"bench.requests">::add(); });
+    auto const atomic = per_op_ns(threads, ops, [](std::size_t) {
+      shared_counter.fetch_add(1, std::memory_order_relaxed);
+    });
+    auto const map = per_op_ns(threads, ops / 16, [](std::size_t) {
+      named_counters.add("bench.requests", 1);
+    });
+    auto const histogram = per_op_ns(threads, ops, [](std::size_t i) {
+      mtp::histogram<"bench.latency_us">::record(i & 1023);
+    });
+    std::printf("%8u %13.2f ns %13.2f ns %13.2f ns %13.2f ns\n", threads, counter, atomic, map,
+                histogram);
+  }
+
+  auto const collect = bench::time_ns(1000, [] {
+    auto snap = mtp::metrics_registry::instance().collect();
+    bench::do_not_optimize(snap);
+  });
+  bench::report("collect (2 metrics, all threads exited)", collect);
+  std::fputs(mtp::metrics_registry::instance().collect().text().c_str(), stdout);
+  return 0;
+}
@@ -0,0 +1,103 @@
+#include "bench.hpp"
+#include "random_keys.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#ifdef MTP_BUILD_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/packed_key.hpp>
+#endif
+
+namespace {
+
+constexpr std::size_t key_count = 1 << 16;
+
+// ticker-like keys: upper-case letters sharing short prefixes
+template <std::size_t N>
+auto
+make_keys(std::size_t n) -> std::vector<mtp::fixed_string<N>>
+{
+  return random_keys::make<mtp::fixed_string<N>>(n, [](std::uint64_t x) { return 'A' + x % 26; });
+}
+
+// sort, binary search and hash-table lookup over `keys`; returns ns per key for each
+template <typename Key>
+auto
+run(std::vector<Key> const& keys) -> void
+{
+  auto const per_key = static_cast<double>(keys.size());
+
+  std::vector<Key> sorted;
+  auto const sort = bench::time_ns(5, [&] {
+    sorted = keys;
+    std::sort(sorted.begin(), sorted.end());
+    bench::clobber();
+  });
+
+  std::size_t found = 0;
+  auto const search = bench::time_ns(5, [&] {
+    for (auto const& k : keys) {
+      found += std::binary_search(sorted.begin(), sorted.end(), k);
+    }
+  });
+
+  std::unordered_map<Key, std::uint32_t> table;
+  auto const insert = bench::time_ns(1, [&] {
+    table.reserve(keys.size());
+    for (std::uint32_t i = 0; i < keys.size(); ++i) {
+      table.emplace(keys[i], i);
+    }
+  });
+  auto const lookup = bench::time_ns(10, [&] {
+    for (auto const& k : keys) {
+      found += table.find(k)->second;
+    }
+  });
+  bench::do_not_optimize(found);
+
+  std::printf("  sort %7.2f  binary search %7.2f  hash insert %7.2f  hash lookup %7.2f ns/key\n",
+              sort / per_key, search / per_key, insert / per_key, lookup / per_key);
+}
+
+template <std::size_t N>
+auto
+run() -> void
+{
+  auto const strings = make_keys<N>(key_count);
+  std::vector<mtp::packed_key<N>> packed;
+  auto const pack = bench::time_ns(10, [&] {
+    packed.clear();
+    for (auto const& s : strings) {
+      packed.emplace_back(s);
+    }
+    bench::clobber();
+  });
+
+  std::printf("%2zu chars, %zu keys (packing %.2f ns/key)\n", N, key_count,
+              pack / static_cast<double>(key_count));
+  std::printf("fixed_string:\n");
+  run(strings);
+  std::printf("packed_key:\n");
+  run(packed);
+}
+
+} // namespace
+
+auto
+main() -> int
+{
+  run<4>();
+  run<8>();
+#ifdef __SIZEOF_INT128__
+  run<12>();
+  run<16>();
+#endif
+  return 0;
+}
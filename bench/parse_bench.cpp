@@ -0,0 +1,123 @@
+#include "bench.hpp"
+#include "random_keys.hpp"
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#ifdef MTP_BUILD_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/parse.hpp>
+#endif
+
+namespace {
+
+constexpr std::size_t field_count = 4096;
+constexpr std::size_t iters = 500;
+
+template <std::size_t N>
+auto
+make_fields() -> std::vector<mtp::fixed_string<N>>
+{
+  return random_keys::make<mtp::fixed_string<N>>(field_count,
+                                                  [](std::uint64_t x) { return '0' + x % 10; });
+}
+
+// digits with a '.' before the last `Frac`, as laid out by `mtp::parse_decimal<Frac>`
+template <std::size_t N, std::size_t Frac>
+auto
+make_decimals() -> std::vector<mtp::fixed_string<N>>
+{
+  auto fields = make_fields<N>();
+  for (auto& f : fields) {
+    f._data[N - 1 - Frac] = '.';
+  }
+  return fields;
+}
+
+template <std::size_t N>
+auto
+run() -> void
+{
+  auto const fields = make_fields<N>();
+  auto const per_field = static_cast<double>(field_count);
+
+  auto const from_chars = bench::time_ns(iters, [&] {
+    std::uint64_t sum = 0;
+    for (auto const& f : fields) {
+      std::uint64_t v = 0;
+      auto const res = std::from_chars(f.data(), f.data() + N, v);
+      sum += v + (res.ec != std::errc{});
+    }
+    bench::do_not_optimize(sum);
+  });
+  auto const swar = bench::time_ns(iters, [&] {
+    std::uint64_t sum = 0;
+    for (auto const& f : fields) {
+      std::errc ec{};
+      sum += mtp::parse<std::uint64_t>(f, ec) + (ec != std::errc{});
+    }
+    bench::do_not_optimize(sum);
+  });
+  std::printf("%2zu digits: from_chars %6.2f ns/field, mtp::parse %6.2f ns/field\n", N,
+              from_chars / per_field, swar / per_field);
+}
+
+template <std::size_t N, std::size_t Frac>
+auto
+run_decimal() -> void
+{
+  auto const fields = make_decimals<N, Frac>();
+  auto const per_field = static_cast<double>(field_count);
+  constexpr auto int_digits = N - 1 - Frac;
+
+  // the usual alternative: parse both parts with from_chars and scale the integer part
+  auto const from_chars = bench::time_ns(iters, [&] {
+    std::uint64_t sum = 0;
+    for (auto const& f : fields) {
+      std::uint64_t int_part = 0;
+      std::uint64_t frac_part = 0;
+      auto const a = std::from_chars(f.data(), f.data() + int_digits, int_part);
+      auto const b = std::from_chars(f.data() + int_digits + 1, f.data() + N, frac_part);
+      std::uint64_t scale = 1;
+      for (auto i = 0u; i < Frac; ++i) {
+        scale *= 10;
+      }
+      sum += int_part * scale + frac_part + (a.ec != std::errc{}) + (b.ec != std::errc{});
+    }
+    bench::do_not_optimize(sum);
+  });
+  auto const swar = bench::time_ns(iters, [&] {
+    std::uint64_t sum = 0;
+    for (auto const& f : fields) {
+      std::errc ec{};
+      sum += mtp::parse_decimal<Frac>(f, ec) + (ec != std::errc{});
+    }
+    bench::do_not_optimize(sum);
+  });
+  std::printf("%2zu chars, %zu fraction digits: from_chars x2 %6.2f ns/field, "
+              "mtp::parse_decimal %6.2f ns/field\n",
+              N, Frac, from_chars / per_field, swar / per_field);
+}
+
+} // namespace
+
+auto
+main() -> int
+{
+  run<4>();
+  run<8>();
+  run<10>();
+  run<12>();
+  run<16>();
+  run<19>();
+  run_decimal<8, 2>();
+  run_decimal<11, 4>();
+  run_decimal<16, 6>();
+  return 0;
+}
@@ -0,0 +1,81 @@
+#include "bench.hpp"
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#ifdef MTP_BUILD_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/record.hpp>
+#endif
+
+namespace {
+
+using trade = mtp::record<mtp::field<"symbol", 8>,
+                          mtp::field<"qty", 10, std::uint64_t>,
+                          mtp::field<"side", 1>,
+                          mtp::field<"price", 12, std::uint64_t>>;
+
+constexpr std::size_t record_count = 100'000;
+constexpr std::size_t iters = 50;
+
+} // namespace
+
+auto
+main() -> int
+{
+  std::string feed;
+  for (std::size_t i = 0; i < record_count; ++i) {
+    char line[trade::size() + 2];
+    std::snprintf(line, sizeof line, "SYM%05zu%010zu%c%012zu\n", i % 100'000, i * 37 % 1'000'000,
+                  i % 2 ? 'B' : 'S', 18'725'000 + i);
+    feed += line;
+  }
+  constexpr auto stride = trade::size() + 1;
+
+  std::vector<std::uint64_t> qty(record_count);
+  std::vector<std::uint64_t> price(record_count);
+  auto const fields = static_cast<double>(2 * record_count);
+
+  // hand-coded offset table + from_chars, as the schemas replace
+  auto const baseline = bench::time_ns(iters, [&] {
+    auto const* p = feed.data();
+    for (std::size_t i = 0; i < record_count; ++i, p += stride) {
+      std::from_chars(p + 8, p + 18, qty[i]);
+      std::from_chars(p + 19, p + 31, price[i]);
+    }
+    bench::do_not_optimize(qty.data());
+    bench::do_not_optimize(price.data());
+  });
+
+  auto const per_record = bench::time_ns(iters, [&] {
+    auto const* p = feed.data();
+    for (std::size_t i = 0; i < record_count; ++i, p += stride) {
+      auto const rec = trade{ p };
+      std::errc ec{};
+      qty[i] = rec.get<"qty">(ec);
+      price[i] = rec.get<"price">(ec);
+    }
+    bench::do_not_optimize(qty.data());
+    bench::do_not_optimize(price.data());
+  });
+
+  auto const columnar = bench::time_ns(iters, [&] {
+    std::errc ec{};
+    trade::decode_column<"qty">(feed, qty, ec, stride);
+    trade::decode_column<"price">(feed, price, ec, stride);
+    bench::do_not_optimize(qty.data());
+    bench::do_not_optimize(price.data());
+  });
+
+  bench::report("offset table + from_chars (per field)", baseline / fields);
+  bench::report("record::get (per field)", per_record / fields);
+  bench::report("record::decode_column (per field)", columnar / fields);
+  return 0;
+}
@@ -0,0 +1,85 @@
+#include "bench.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef MTP_BUILD_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/router.hpp>
+#endif
+
+namespace {
+
+constexpr std::size_t iters = 2000;
+
+using router = mtp::prefix_router<"/api/", "/api/v1/", "/api/v1/users/", "/api/v1/orders/",
+                                  "/api/v2/", "/api/v2/users/", "/api/v2/orders/",
+                                  "/api/v2/orders/history/", "/api/v2/accounts/", "/health",
+                                  "/metrics", "/static/", "/static/assets/images/",
+                                  "/static/assets/css/", "/admin/", "/admin/settings/">;
+
+// the current approach: walk every entry of a std::map and keep the longest `starts_with`
+auto
+map_match(std::map<std::string, std::size_t, std::less<>> const& routes, std::string_view path)
+  -> std::size_t
+{
+  std::size_t best = mtp::route_match::npos;
+  std::size_t best_len = 0;
+  for (auto const& [route, index] : routes) {
+    if (path.starts_with(route) && (best == mtp::route_match::npos || route.size() > best_len)) {
+      best = index;
+      best_len = route.size();
+    }
+  }
+  return best;
+}
+
+} // namespace
+
+auto
+main() -> int
+{
+  std::map<std::string, std::size_t, std::less<>> routes;
+  for (std::size_t i = 0; i < router::size(); ++i) {
+    routes.emplace(std::string{ router::route(i) }, i);
+  }
+
+  std::vector<std::string> paths;
+  std::uint64_t x = 88172645463325252u;
+  char const* const tails[] = { "42", "", "item/7", "x", "v3/anything/else", "logo.png" };
+  for (std::size_t i = 0; i < 1024; ++i) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    auto route = std::string{ router::route(x % router::size()) };
+    if (x % 7 == 0) {
+      route.resize(route.size() / 2); // a partial route, often matching a shorter one or none
+    }
+    paths.push_back(route + tails[(x >> 8) % 6]);
+  }
+  auto const per_path = static_cast<double>(paths.size());
+
+  auto const map_ns = bench::time_ns(iters, [&] {
+    std::size_t sum = 0;
+    for (auto const& p : paths) {
+      sum += map_match(routes, p);
+    }
+    bench::do_not_optimize(sum);
+  });
+  auto const trie_ns = bench::time_ns(iters, [&] {
+    std::size_t sum = 0;
+    for (auto const& p : paths) {
+      sum += router::match(p).index;
+    }
+    bench::do_not_optimize(sum);
+  });
+  bench::report("std::map + starts_with (16 routes)", map_ns / per_path);
+  bench::report("mtp::prefix_router (16 routes)", trie_ns / per_path);
+  return 0;
+}
@@ -0,0 +1,72 @@
+#include "bench.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#ifdef MTP_BUILD_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/splitter.hpp>
+#endif
+
+namespace {
+
+auto
+make_input() -> std::string
+{
+  std::string s;
+  for (auto i = 0; i < 20'000; ++i) {
+    s += "symbol=AAPL;qty=" + std::to_string(i * 37 % 10'000) +
+         ";price=187.25,venue=XNAS;side=buy,account=ACCT" + std::to_string(i) + ";note=;";
+  }
+  return s;
+}
+
+auto
+count_find_first_of(std::string_view str) -> std::size_t
+{
+  std::size_t tokens = 0;
+  std::size_t pos = 0;
+  for (;;) {
+    ++tokens;
+    auto const next = str.find_first_of(",;=", pos);
+    if (next == std::string_view::npos) {
+      return tokens;
+    }
+    pos = next + 1;
+  }
+}
+
+template <typename Splitter>
+auto
+count_splitter(std::string_view str) -> std::size_t
+{
+  std::size_t tokens = 0;
+  for (auto token : Splitter::split(str)) {
+    bench::do_not_optimize(token);
+    ++tokens;
+  }
+  return tokens;
+}
+
+} // namespace
+
+auto
+main() -> int
+{
+  auto const input = make_input();
+  auto const bytes = static_cast<double>(input.size());
+  constexpr std::size_t iters = 50;
+
+  bench::report("string_view::find_first_of (bytes)", bench::time_ns(iters, [&] {
+                  bench::do_not_optimize(count_find_first_of(input));
+                }) / bytes);
+  bench::report("mtp::splitter<\",;=\"> (bytes)", bench::time_ns(iters, [&] {
+                  bench::do_not_optimize(count_splitter<mtp::splitter<",;=">>(input));
+                }) / bytes);
+  bench::report("mtp::splitter<\",;=\", '\"'> (bytes)", bench::time_ns(iters, [&] {
+                  bench::do_not_optimize(count_splitter<mtp::splitter<",;=", '"'>>(input));
+                }) / bytes);
+  return 0;
+}
@@ -0,0 +1,61 @@
+#include "bench.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+
+#ifdef MTP_BUILD_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/fixed_string.hpp>
+#endif
+
+namespace {
+
+constexpr std::size_t N = 64;
+constexpr std::size_t iters = 5'000'000;
+
+// What callers had to do before: copy out, modify, rebuild through the iterator constructor.
+auto
+lower_by_rebuild(mtp::fixed_string<N> const& fs) -> mtp::fixed_string<N>
+{
+  char tmp[N];
+  std::transform(fs.begin(), fs.end(), tmp, [](char c) {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  });
+  return mtp::fixed_string<N>{ tmp, tmp + N };
+}
+
+} // namespace
+
+auto
+main() -> int
+{
+  char src[N];
+  for (std::size_t i = 0; i < N; ++i) {
+    src[i] = static_cast<char>("Hello, World! SYMBOL=AAPL "[i % 26]);
+  }
+  auto fs = mtp::fixed_string<N>{ src, src + N };
+
+  bench::report("rebuild via iterator constructor", bench::time_ns(iters, [&] {
+                  fs = lower_by_rebuild(fs);
+                  bench::do_not_optimize(fs);
+                }),
+                N);
+  bench::report("to_lower_inplace", bench::time_ns(iters, [&] {
+                  fs.to_lower_inplace();
+                  bench::do_not_optimize(fs);
+                }),
+                N);
+  bench::report("replace", bench::time_ns(iters, [&] {
+                  fs.replace('a', 'b');
+                  bench::do_not_optimize(fs);
+                }),
+                N);
+  bench::report("fill", bench::time_ns(iters, [&] {
+                  fs.fill('*');
+                  bench::do_not_optimize(fs);
+                }),
+                N);
+  return 0;
+}
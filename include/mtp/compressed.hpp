@@ -0,0 +1,457 @@
+#ifndef MTP_COMPRESSED_HPP
+#define MTP_COMPRESSED_HPP
+
+// -------------------------------------------------------------------------------------------------
+
+#include <mtp/fixed_string.hpp>
+
+// -------------------------------------------------------------------------------------------------
+
+#ifndef MTP_EXPORT
+#  define MTP_EXPORT
+#endif
+
+// Every member of `compressed<Str>` spells out all of `Str` in its mangled name; hidden visibility
+// keeps those names out of the dynamic symbol table of shared libraries.
+#if defined(__GNUC__) || defined(__clang__)
+#  define MTP_COMPRESSED_HIDDEN __attribute__((visibility("hidden")))
+#else
+#  define MTP_COMPRESSED_HIDDEN
+#endif
+
+#ifndef MTP_EXPECTS
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    define MTP_EXPECTS(cond) __assume(cond)
+#  elif defined(__GNUC__) || defined(__clang__)
+#    define MTP_EXPECTS(cond) ((cond) ? static_cast<void>(0) : __builtin_unreachable())
+#  else
+#    define MTP_EXPECTS(cond)
+#  endif
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+#ifndef MTP_BUILD_MODULE
+#  include <array>
+#  include <cstddef>
+#  include <cstdint>
+#  include <iterator>
+#  include <string_view>
+#  include <type_traits>
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+namespace mtp {
+
+// -------------------------------------------------------------------------------------------------
+// lz codec
+// -------------------------------------------------------------------------------------------------
+//
+// Byte oriented LZ77 variant (LZ4 block layout). Every sequence is
+//
+//   token | [literal length ext] | literals | offset (u16 le) | [match length ext]
+//
+// where the high nibble of the token is the literal count and the low nibble the match length
+// minus `min_match` (15 means "continued in following bytes, 255 at a time"). Literals are stored
+// as `sizeof(CharT)` little-endian bytes. The final sequence carries literals only; decoding stops
+// once `N` characters have been produced.
+
+namespace detail::lz {
+
+inline constexpr std::size_t min_match = 4;
+inline constexpr std::size_t max_offset = 4096;
+inline constexpr std::size_t hash_bits = 12;
+
+[[nodiscard]] constexpr auto
+bound(std::size_t n, std::size_t char_size) noexcept -> std::size_t
+{
+  return n * char_size + n / 255 + 16;
+}
+
+template <typename CharT>
+[[nodiscard]] constexpr auto
+hash(CharT const* p) noexcept -> std::size_t
+{
+  std::uint32_t v = 0;
+  for (auto i = 0u; i < min_match; ++i) {
+    v = (v << 8) ^ static_cast<std::uint32_t>(p[i]);
+  }
+  return static_cast<std::size_t>((v * 2654435761u) >> (32 - hash_bits));
+}
+
+template <std::size_t Capacity>
+struct buffer
+{
+  std::uint8_t bytes[Capacity]{};
+  std::size_t size = 0;
+
+  constexpr auto
+  put(std::uint8_t b) noexcept -> void
+  {
+    bytes[size++] = b;
+  }
+
+  constexpr auto
+  put_length(std::size_t len) noexcept -> void
+  {
+    for (; len >= 255; len -= 255) {
+      put(255);
+    }
+    put(static_cast<std::uint8_t>(len));
+  }
+
+  template <typename CharT>
+  constexpr auto
+  put_char(CharT c) noexcept -> void
+  {
+    using U = std::make_unsigned_t<CharT>;
+    auto v = static_cast<U>(c);
+    for (auto i = 0u; i < sizeof(CharT); ++i) {
+      put(static_cast<std::uint8_t>(v & 0xFF));
+      v = static_cast<U>(v >> 8);
+    }
+  }
+
+  template <typename CharT>
+  constexpr auto
+  put_sequence(CharT const* lit, std::size_t lit_len, std::size_t offset, std::size_t match_len)
+      -> void
+  {
+    auto const lit_nib = lit_len < 15 ? lit_len : 15;
+    auto const match_nib =
+        match_len == 0 ? 0 : (match_len - min_match < 15 ? match_len - min_match : 15);
+    put(static_cast<std::uint8_t>((lit_nib << 4) | match_nib));
+    if (lit_nib == 15) {
+      put_length(lit_len - 15);
+    }
+    for (auto i = 0u; i < lit_len; ++i) {
+      put_char(lit[i]);
+    }
+    if (match_len == 0) {
+      return;
+    }
+    put(static_cast<std::uint8_t>(offset & 0xFF));
+    put(static_cast<std::uint8_t>(offset >> 8));
+    if (match_nib == 15) {
+      put_length(match_len - min_match - 15);
+    }
+  }
+};
+
+template <typename CharT, std::size_t N>
+[[nodiscard]] constexpr auto
+compress(basic_fixed_string<CharT, N> const& str) noexcept
+{
+  auto out = buffer<bound(N, sizeof(CharT))>{};
+  auto const* src = str.data();
+
+  constexpr auto npos = static_cast<std::size_t>(-1);
+  std::size_t table[std::size_t{ 1 } << hash_bits];
+  for (auto& e : table) {
+    e = npos;
+  }
+
+  std::size_t anchor = 0;
+  std::size_t i = 0;
+  while (N >= min_match && i + min_match <= N) {
+    auto const h = hash(src + i);
+    auto const cand = table[h];
+    table[h] = i;
+
+    auto len = std::size_t{ 0 };
+    if (cand != npos && i - cand <= max_offset) {
+      while (i + len < N && src[cand + len] == src[i + len]) {
+        ++len;
+      }
+    }
+    if (len < min_match) {
+      ++i;
+      continue;
+    }
+
+    out.put_sequence(src + anchor, i - anchor, i - cand, len);
+    for (auto j = i + 1; j < i + len && j + min_match <= N; ++j) {
+      table[hash(src + j)] = j;
+    }
+    i += len;
+    anchor = i;
+  }
+  out.put_sequence(src + anchor, N - anchor, 0, 0);
+  return out;
+}
+
+template <typename CharT>
+struct reader
+{
+  std::uint8_t const* pos;
+
+  constexpr auto
+  get() noexcept -> std::uint8_t
+  {
+    return *pos++;
+  }
+
+  constexpr auto
+  get_length(std::size_t nib) noexcept -> std::size_t
+  {
+    if (nib != 15) {
+      return nib;
+    }
+    for (std::uint8_t b = 255; b == 255;) {
+      b = get();
+      nib += b;
+    }
+    return nib;
+  }
+
+  constexpr auto
+  get_char() noexcept -> CharT
+  {
+    using U = std::make_unsigned_t<CharT>;
+    U v = 0;
+    for (auto i = 0u; i < sizeof(CharT); ++i) {
+      v = static_cast<U>(v | (static_cast<U>(get()) << (8 * i)));
+    }
+    return static_cast<CharT>(v);
+  }
+};
+
+template <typename CharT>
+constexpr auto
+decompress(std::uint8_t const* src, CharT* dst, std::size_t n) noexcept -> void
+{
+  auto in = reader<CharT>{ src };
+  std::size_t out = 0;
+  for (;;) {
+    auto const token = in.get();
+    for (auto lit = in.get_length(token >> 4); lit > 0; --lit) {
+      dst[out++] = in.get_char();
+    }
+    if (out >= n) {
+      break;
+    }
+    std::size_t offset = in.get();
+    offset |= std::size_t{ in.get() } << 8;
+    auto len = in.get_length(token & 0x0F) + min_match;
+    MTP_EXPECTS(offset != 0 && offset <= out && out + len <= n);
+    for (; len > 0; --len, ++out) {
+      dst[out] = dst[out - offset];
+    }
+  }
+  dst[n] = CharT{};
+}
+
+} // namespace detail::lz
+
+// -------------------------------------------------------------------------------------------------
+// decompression stream
+// -------------------------------------------------------------------------------------------------
+
+// Single-pass view decoding a compressed block one character at a time. Memory use is bounded
+// by the codec window (`min(N, 4096)` characters) rather than by `N`.
+MTP_EXPORT template <typename CharT, std::size_t N>
+class basic_decompress_stream
+{
+  static constexpr std::size_t window = N < detail::lz::max_offset ? N : detail::lz::max_offset;
+
+  detail::lz::reader<CharT> _in;
+  std::size_t _produced = 0;
+  std::size_t _literals = 0;
+  std::size_t _matches = 0;
+  std::size_t _offset = 0;
+  std::uint8_t _token = 0;
+  CharT _current{};
+  CharT _history[window + 1]{};
+
+  constexpr auto
+  read_match() noexcept -> void
+  {
+    _offset = _in.get();
+    _offset |= std::size_t{ _in.get() } << 8;
+    _matches = _in.get_length(_token & 0x0F) + detail::lz::min_match;
+  }
+
+  constexpr auto
+  next() noexcept -> void
+  {
+    if (_literals == 0 && _matches == 0) {
+      _token = _in.get();
+      _literals = _in.get_length(_token >> 4);
+      if (_literals == 0) {
+        read_match();
+      }
+    }
+
+    if (_literals > 0) {
+      _current = _in.get_char();
+      if (--_literals == 0 && _produced + 1 < N) {
+        read_match();
+      }
+    } else {
+      _current = _history[(_produced - _offset) % (window + 1)];
+      --_matches;
+    }
+    _history[_produced % (window + 1)] = _current;
+    ++_produced;
+  }
+
+public:
+  class iterator
+  {
+    basic_decompress_stream* _stream = nullptr;
+
+  public:
+    using iterator_concept = std::input_iterator_tag;
+    using value_type = CharT;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+
+    constexpr explicit iterator(basic_decompress_stream& s) noexcept : _stream{ &s } {}
+
+    [[nodiscard]] constexpr auto
+    operator*() const noexcept -> CharT
+    {
+      return _stream->_current;
+    }
+
+    constexpr auto
+    operator++() noexcept -> iterator&
+    {
+      if (_stream->_produced < N) {
+        _stream->next();
+      } else {
+        _stream->_produced = N + 1;
+      }
+      return *this;
+    }
+
+    constexpr auto
+    operator++(int) noexcept -> void
+    {
+      ++*this;
+    }
+
+    [[nodiscard]] constexpr auto
+    operator==(std::default_sentinel_t) const noexcept -> bool
+    {
+      return _stream->_produced > N;
+    }
+  };
+
+  constexpr explicit basic_decompress_stream(std::uint8_t const* src) noexcept : _in{ src }
+  {
+    if constexpr (N > 0) {
+      next();
+    } else {
+      _produced = N + 1;
+    }
+  }
+
+  [[nodiscard]] constexpr auto
+  begin() noexcept -> iterator
+  {
+    return iterator{ *this };
+  }
+
+  [[nodiscard]] constexpr auto
+  end() const noexcept -> std::default_sentinel_t
+  {
+    return std::default_sentinel;
+  }
+
+  [[nodiscard]] static constexpr auto
+  size() noexcept -> std::size_t
+  {
+    return N;
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
+// compressed
+// -------------------------------------------------------------------------------------------------
+
+// Compile-time compressed constant. Only the compressed bytes are emitted as data (as long as
+// `Str` itself is not odr-used); the text is decompressed on first access into a thread-safe,
+// lazily initialized buffer, or streamed through `stream()`. The members have hidden visibility,
+// so stripped binaries and shared libraries carry no symbol names spelling out `Str`; each shared
+// library decompresses its own copy.
+MTP_EXPORT template <basic_fixed_string Str>
+struct MTP_COMPRESSED_HIDDEN compressed
+{
+private:
+  using string_type = std::remove_cvref_t<decltype(Str)>;
+  static constexpr auto _encoded = detail::lz::compress(Str);
+
+  struct storage
+  {
+    typename string_type::value_type data[string_type::size() + 1];
+
+    storage() noexcept
+    {
+      detail::lz::decompress(bytes.data(), data, string_type::size());
+    }
+  };
+
+  [[nodiscard]] static auto
+  buffer() noexcept -> storage const&
+  {
+    static storage const s{};
+    return s;
+  }
+
+public:
+  using value_type = typename string_type::value_type;
+  using size_type = std::size_t;
+  using stream_type = basic_decompress_stream<value_type, string_type::size()>;
+
+  static constexpr std::array<std::uint8_t, _encoded.size> bytes = [] {
+    std::array<std::uint8_t, _encoded.size> a{};
+    for (auto i = 0u; i < _encoded.size; ++i) {
+      a[i] = _encoded.bytes[i];
+    }
+    return a;
+  }();
+
+  static constexpr std::integral_constant<size_type, string_type::size()> size{};
+  static constexpr std::integral_constant<size_type, bytes.size()> compressed_size{};
+
+  [[nodiscard]] static auto
+  c_str() noexcept -> value_type const*
+  {
+    return buffer().data;
+  }
+
+  [[nodiscard]] static auto
+  view() noexcept -> std::basic_string_view<value_type>
+  {
+    return { buffer().data, size() };
+  }
+
+  [[nodiscard]] static constexpr auto
+  str() noexcept -> string_type
+  {
+    value_type buf[size() + 1];
+    detail::lz::decompress(bytes.data(), buf, size());
+    return string_type{ buf, buf + size() };
+  }
+
+  [[nodiscard]] static constexpr auto
+  stream() noexcept -> stream_type
+  {
+    return stream_type{ bytes.data() };
+  }
+};
+
+} // namespace mtp
+
+// -------------------------------------------------------------------------------------------------
+
+#undef MTP_EXPORT
+#undef MTP_EXPECTS
+#undef MTP_COMPRESSED_HIDDEN
+
+// -------------------------------------------------------------------------------------------------
+
+#endif // MTP_COMPRESSED_HPP
@@ -29,6 +29,14 @@
 #  define MTP_THROW(except)
 #endif
 
+#if defined(_MSC_VER) && !defined(__clang__)
+#  define MTP_NOINLINE __declspec(noinline)
+#elif defined(__GNUC__) || defined(__clang__)
+#  define MTP_NOINLINE __attribute__((noinline))
+#else
+#  define MTP_NOINLINE
+#endif
+
 #if __has_cpp_attribute(unlikely)
 #  define MTP_UNLIKELY [[unlikely]]
 #else
@@ -50,6 +58,7 @@
 #    include <format>
 #  endif
 #  include <functional>
+#  include <iosfwd>
 #  include <iterator>
 #  if defined(__cpp_lib_containers_ranges) || defined(__cpp_lib_ranges_to_container)
 #    include <ranges>
@@ -89,6 +98,58 @@ using fixed_u16string = basic_fixed_string<char16_t, N>;
 MTP_EXPORT template <std::size_t N>
 using fixed_u32string = basic_fixed_string<char32_t, N>;
 
+// -------------------------------------------------------------------------------------------------
+// runtime kernels
+// -------------------------------------------------------------------------------------------------
+//
+// Out-of-line runtime paths shared by every `N` of a character type, so a program using many
+// distinct lengths carries one copy per character type instead of one per length. Strings of at
+// most `inline_kernel_bytes` stay inline where the compiler specializes on the constant length.
+
+namespace detail {
+
+inline constexpr std::size_t inline_kernel_bytes = 16;
+
+template <typename CharT>
+MTP_NOINLINE auto
+equal_kernel(CharT const* lhs, CharT const* rhs, std::size_t n) noexcept -> bool
+{
+  return std::basic_string_view<CharT>{ lhs, n } == std::basic_string_view<CharT>{ rhs, n };
+}
+
+template <typename CharT>
+MTP_NOINLINE auto
+compare_kernel(CharT const* lhs, std::size_t lhs_n, CharT const* rhs, std::size_t rhs_n) noexcept
+    -> int
+{
+  return std::basic_string_view<CharT>{ lhs, lhs_n }.compare(
+      std::basic_string_view<CharT>{ rhs, rhs_n });
+}
+
+template <typename CharT>
+MTP_NOINLINE auto
+swap_kernel(CharT* lhs, CharT* rhs, std::size_t n) noexcept -> void
+{
+  std::swap_ranges(lhs, lhs + n, rhs);
+}
+
+template <typename CharT>
+MTP_NOINLINE auto
+write_kernel(std::basic_ostream<CharT>& os, CharT const* str, std::size_t n)
+    -> std::basic_ostream<CharT>&
+{
+  return os << std::basic_string_view<CharT>{ str, n };
+}
+
+template <typename CharT, std::size_t N>
+[[nodiscard]] constexpr auto
+use_inline_kernel() noexcept -> bool
+{
+  return N * sizeof(CharT) <= inline_kernel_bytes;
+}
+
+} // namespace detail
+
 template <typename CharT, std::size_t N>
 struct basic_fixed_string
 {
@@ -294,7 +355,11 @@ struct basic_fixed_string
   constexpr auto
   swap(basic_fixed_string& fs) noexcept -> void
   {
-    std::swap_ranges(_data, _data + size(), fs._data);
+    if (std::is_constant_evaluated() || detail::use_inline_kernel<CharT, N>()) {
+      std::swap_ranges(_data, _data + size(), fs._data);
+    } else {
+      detail::swap_kernel(_data, fs._data, size());
+    }
   }
 
   friend constexpr auto
@@ -303,6 +368,62 @@ struct basic_fixed_string
     return a.swap(b);
   }
 
+  // In-place modifiers. The loops run over the compile-time length with branch-free bodies so the
+  // compiler can vectorize them; the terminating null is never touched.
+
+  constexpr auto
+  fill(CharT c) noexcept -> basic_fixed_string&
+  {
+    for (auto i = 0u; i < N; ++i) {
+      _data[i] = c;
+    }
+    return *this;
+  }
+
+  constexpr auto
+  replace(CharT old_char, CharT new_char) noexcept -> basic_fixed_string&
+  {
+    for (auto i = 0u; i < N; ++i) {
+      _data[i] = _data[i] == old_char ? new_char : _data[i];
+    }
+    return *this;
+  }
+
+  template <typename F>
+    requires(std::is_convertible_v<std::invoke_result_t<F&, CharT>, CharT>)
+  constexpr auto
+  transform(F f) noexcept(std::is_nothrow_invocable_v<F&, CharT>) -> basic_fixed_string&
+  {
+    for (auto i = 0u; i < N; ++i) {
+      _data[i] = static_cast<CharT>(std::invoke(f, _data[i]));
+    }
+    return *this;
+  }
+
+  // ASCII only; other characters are left unchanged
+  constexpr auto
+  to_lower_inplace() noexcept -> basic_fixed_string&
+  {
+    using U = std::make_unsigned_t<CharT>;
+    for (auto i = 0u; i < N; ++i) {
+      auto const c = static_cast<U>(_data[i]);
+      auto const upper = static_cast<U>(c - U{ 'A' }) < U{ 26 };
+      _data[i] = static_cast<CharT>(c | static_cast<U>(upper << 5));
+    }
+    return *this;
+  }
+
+  template <std::size_t Pos, std::size_t N2>
+    requires(Pos + N2 <= N)
+  constexpr auto
+  overwrite(basic_fixed_string<CharT, N2> const& fs) noexcept -> basic_fixed_string&
+  {
+    for (auto i = 0u; i < N2; ++i) {
+      _data[Pos + i] = fs._data[i];
+    }
+    return *this;
+  }
+
   // -----------------------------------------------------------------------------------------------
   // string operators
   // -----------------------------------------------------------------------------------------------
@@ -392,7 +513,14 @@ struct basic_fixed_string
   operator==(basic_fixed_string const& lhs, basic_fixed_string<CharT, N2> const& rhs) noexcept
       -> bool
   {
-    return lhs.view() == rhs.view();
+    if constexpr (N != N2) {
+      return false;
+    } else {
+      if (std::is_constant_evaluated() || detail::use_inline_kernel<CharT, N>()) {
+        return lhs.view() == rhs.view();
+      }
+      return detail::equal_kernel(lhs.data(), rhs.data(), N);
+    }
   }
 
   template <std::size_t N2>
@@ -409,7 +537,10 @@ struct basic_fixed_string
   operator<=>(basic_fixed_string const& lhs, basic_fixed_string<CharT, N2> const& rhs) noexcept
       -> std::strong_ordering
   {
-    return lhs.view() <=> rhs.view();
+    if (std::is_constant_evaluated() || detail::use_inline_kernel<CharT, (N < N2 ? N : N2)>()) {
+      return lhs.view() <=> rhs.view();
+    }
+    return detail::compare_kernel(lhs.data(), N, rhs.data(), N2) <=> 0;
   }
 
   template <std::size_t N2>
@@ -427,10 +558,14 @@ struct basic_fixed_string
   // -----------------------------------------------------------------------------------------------
 
   friend auto
-  operator<<(std::basic_ostream<CharT>& os, basic_fixed_string const& fs) noexcept
+  operator<<(std::basic_ostream<CharT>& os, basic_fixed_string const& fs)
       -> std::basic_ostream<CharT>&
   {
-    return os << fs.view();
+    if constexpr (detail::use_inline_kernel<CharT, N>()) {
+      return os << fs.view();
+    } else {
+      return detail::write_kernel(os, fs.data(), N);
+    }
   }
 }; // basic_fixed_string
 
@@ -469,6 +604,34 @@ template <concepts::char_type CharT, std::size_t N>
 basic_fixed_string(std::from_range_t, std::array<CharT, N>) -> basic_fixed_string<CharT, N>;
 #endif
 
+// -------------------------------------------------------------------------------------------------
+// explicit instantiation declarations
+// -------------------------------------------------------------------------------------------------
+//
+// The module library build instantiates the kernels once (module/fixed_string_kernels.cpp).
+
+#ifdef MTP_BUILD_MODULE
+#  define MTP_EXTERN_KERNELS(CharT)                                                               \
+    extern template auto detail::equal_kernel<CharT>(CharT const*, CharT const*,                  \
+                                                     std::size_t) noexcept -> bool;               \
+    extern template auto detail::compare_kernel<CharT>(CharT const*, std::size_t, CharT const*,   \
+                                                       std::size_t) noexcept -> int;              \
+    extern template auto detail::swap_kernel<CharT>(CharT*, CharT*, std::size_t) noexcept        \
+        -> void;                                                                                  \
+    extern template auto detail::write_kernel<CharT>(std::basic_ostream<CharT>&, CharT const*,    \
+                                                     std::size_t) -> std::basic_ostream<CharT>&
+
+MTP_EXTERN_KERNELS(char);
+MTP_EXTERN_KERNELS(wchar_t);
+#  ifdef __cpp_char8_t
+MTP_EXTERN_KERNELS(char8_t);
+#  endif
+MTP_EXTERN_KERNELS(char16_t);
+MTP_EXTERN_KERNELS(char32_t);
+
+#  undef MTP_EXTERN_KERNELS
+#endif
+
 } // namespace mtp
 
 // -------------------------------------------------------------------------------------------------
@@ -502,17 +665,10 @@ struct std::hash<mtp::fixed_u32string<N>> : std::hash<std::u32string_view>
 // -------------------------------------------------------------------------------------------------
 
 #ifdef __cpp_lib_format
+// Every `N` reuses the `basic_string_view` formatter; strings convert implicitly on the way in.
 MTP_EXPORT template <typename CharT, std::size_t N>
 struct std::formatter<mtp::basic_fixed_string<CharT, N>> : formatter<std::basic_string_view<CharT>>
-{
-  template <typename FmtCtx>
-  auto
-  format(mtp::basic_fixed_string<CharT, N> const& str, FmtCtx& ctx) const -> decltype(ctx.out())
-  {
-    return formatter<std::basic_string_view<CharT>>::format(std::basic_string_view<CharT>(str),
-                                                            ctx);
-  }
-};
+{};
 #endif
 
 // -------------------------------------------------------------------------------------------------
@@ -520,6 +676,7 @@ struct std::formatter<mtp::basic_fixed_string<CharT, N>> : formatter<std::basic_
 #undef MTP_EXPORT
 #undef MTP_EXPECTS
 #undef MTP_THROW
+#undef MTP_NOINLINE
 #undef MTP_UNLIKELY
 
 // -------------------------------------------------------------------------------------------------
@@ -0,0 +1,287 @@
+#ifndef MTP_HASH_HPP
+#define MTP_HASH_HPP
+
+// -------------------------------------------------------------------------------------------------
+
+#include <mtp/fixed_string.hpp>
+
+// -------------------------------------------------------------------------------------------------
+
+#ifndef MTP_EXPORT
+#  define MTP_EXPORT
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define MTP_HASH_SSE2
+#endif
+
+#ifndef MTP_EXPECTS
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    define MTP_EXPECTS(cond) __assume(cond)
+#  elif defined(__GNUC__) || defined(__clang__)
+#    define MTP_EXPECTS(cond) ((cond) ? static_cast<void>(0) : __builtin_unreachable())
+#  else
+#    define MTP_EXPECTS(cond)
+#  endif
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+#ifndef MTP_BUILD_MODULE
+#  include <bit>
+#  include <cstddef>
+#  include <cstdint>
+#  include <cstring>
+#  include <span>
+#  include <thread>
+#  include <type_traits>
+#  include <utility>
+#  include <vector>
+#endif
+#if defined(MTP_HASH_SSE2)
+#  include <emmintrin.h>
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+namespace mtp {
+
+// -------------------------------------------------------------------------------------------------
+// hash kernel
+// -------------------------------------------------------------------------------------------------
+//
+// A hash over 64-bit words of packed characters. Every key of a `basic_fixed_string<CharT, N>` has
+// the same number of words, so `hash_many` runs `lanes` keys in lock step with the lane loop
+// innermost, which maps lanes onto vector registers.
+
+namespace detail::hash {
+
+inline constexpr std::size_t lanes = 8;
+inline constexpr std::uint64_t k0 = 0x9E3779B97F4A7C15u;
+inline constexpr std::uint64_t k1 = 0xBF58476D1CE4E5B9u;
+inline constexpr std::uint64_t k2 = 0x94D049BB133111EBu;
+
+template <typename CharT>
+inline constexpr std::size_t chars_per_word = sizeof(std::uint64_t) / sizeof(CharT);
+
+template <typename CharT, std::size_t N>
+inline constexpr std::size_t words = (N + chars_per_word<CharT> - 1) / chars_per_word<CharT>;
+
+// word `w` of `str`: characters packed by value (not by memory layout), zero padded at the end
+template <std::size_t W, typename CharT, std::size_t N>
+[[nodiscard]] constexpr auto
+word(CharT const* str) noexcept -> std::uint64_t
+{
+  constexpr auto per = chars_per_word<CharT>;
+  constexpr auto first = W * per;
+  constexpr auto count = N - first < per ? N - first : per;
+  std::uint64_t v = 0;
+  if constexpr (std::endian::native == std::endian::little) {
+    // on little-endian targets the packed word is the memory image; a fixed-size memcpy is a
+    // single load, where the shift loop below is not reliably merged
+    if (!std::is_constant_evaluated()) {
+      std::memcpy(&v, str + first, count * sizeof(CharT));
+      return v;
+    }
+  }
+  for (auto i = 0u; i < count; ++i) {
+    using U = std::make_unsigned_t<CharT>;
+    v |= std::uint64_t{ static_cast<U>(str[first + i]) } << (8 * sizeof(CharT) * i);
+  }
+  return v;
+}
+
+// per-position key: splitmix64 of the word index
+[[nodiscard]] constexpr auto
+secret(std::size_t w) noexcept -> std::uint64_t
+{
+  auto z = (w + 1) * k0;
+  z = (z ^ (z >> 30)) * k1;
+  z = (z ^ (z >> 27)) * k2;
+  return z ^ (z >> 31);
+}
+
+[[nodiscard]] constexpr auto
+init(std::uint64_t seed, std::size_t bytes) noexcept -> std::uint64_t
+{
+  return (seed ^ k0) + bytes * k1;
+}
+
+// Words are accumulated independently (a 32x32->64 product of the keyed word plus the word with
+// its halves swapped, as in XXH3), so there is no dependency chain within a key and each word
+// costs one narrow multiply; all mixing between words happens in `finalize`.
+[[nodiscard]] constexpr auto
+round(std::uint64_t w, std::uint64_t s) noexcept -> std::uint64_t
+{
+  auto const x = w ^ s;
+  return (x & 0xFFFFFFFFu) * (x >> 32) + ((w << 32) | (w >> 32));
+}
+
+[[nodiscard]] constexpr auto
+finalize(std::uint64_t h) noexcept -> std::uint64_t
+{
+  h ^= h >> 33;
+  h *= k1;
+  h ^= h >> 29;
+  h *= k2;
+  h ^= h >> 32;
+  return h;
+}
+
+template <typename CharT, std::size_t N, std::size_t... Ws>
+[[nodiscard]] constexpr auto
+one(basic_fixed_string<CharT, N> const& key, std::uint64_t seed,
+    std::index_sequence<Ws...>) noexcept -> std::uint64_t
+{
+  auto h = init(seed, N * sizeof(CharT));
+  ((h += round(word<Ws, CharT, N>(key.data()), secret(Ws))), ...);
+  return finalize(h);
+}
+
+template <typename CharT, std::size_t N, std::size_t... Ws>
+auto
+block(basic_fixed_string<CharT, N> const* keys, std::uint64_t* out, std::uint64_t seed,
+      std::index_sequence<Ws...>) noexcept -> void
+{
+  std::uint64_t h[lanes];
+#if defined(MTP_HASH_SSE2)
+  // two lanes per register; `pmuludq` is the 32x32->64 multiply of `round`
+  __m128i acc[lanes / 2];
+  for (auto l = 0u; l < lanes / 2; ++l) {
+    acc[l] = _mm_set1_epi64x(static_cast<long long>(init(seed, N * sizeof(CharT))));
+  }
+  auto step = [&]<std::size_t W>(std::integral_constant<std::size_t, W>) {
+    auto const s = _mm_set1_epi64x(static_cast<long long>(secret(W)));
+    for (auto l = 0u; l < lanes / 2; ++l) {
+      auto const w0 = word<W, CharT, N>(keys[2 * l].data());
+      auto const w1 = word<W, CharT, N>(keys[2 * l + 1].data());
+      auto const w = _mm_set_epi64x(static_cast<long long>(w1), static_cast<long long>(w0));
+      auto const x = _mm_xor_si128(w, s);
+      auto const p = _mm_mul_epu32(x, _mm_srli_epi64(x, 32));
+      auto const swapped = _mm_shuffle_epi32(w, _MM_SHUFFLE(2, 3, 0, 1));
+      acc[l] = _mm_add_epi64(acc[l], _mm_add_epi64(p, swapped));
+    }
+  };
+  (step(std::integral_constant<std::size_t, Ws>{}), ...);
+  for (auto l = 0u; l < lanes / 2; ++l) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(h + 2 * l), acc[l]);
+  }
+#else
+  for (auto l = 0u; l < lanes; ++l) {
+    h[l] = init(seed, N * sizeof(CharT));
+  }
+  auto step = [&]<std::size_t W>(std::integral_constant<std::size_t, W>) {
+    for (auto l = 0u; l < lanes; ++l) {
+      h[l] += round(word<W, CharT, N>(keys[l].data()), secret(W));
+    }
+  };
+  (step(std::integral_constant<std::size_t, Ws>{}), ...);
+#endif
+  for (auto l = 0u; l < lanes; ++l) {
+    out[l] = finalize(h[l]);
+  }
+}
+
+template <typename CharT, std::size_t N>
+auto
+many(basic_fixed_string<CharT, N> const* keys, std::uint64_t* out, std::size_t n,
+     std::uint64_t seed) noexcept -> void
+{
+  constexpr auto ws = std::make_index_sequence<words<CharT, N>>{};
+  std::size_t i = 0;
+  for (; i + lanes <= n; i += lanes) {
+    block(keys + i, out + i, seed, ws);
+  }
+  for (; i < n; ++i) {
+    out[i] = one(keys[i], seed, ws);
+  }
+}
+
+} // namespace detail::hash
+
+// -------------------------------------------------------------------------------------------------
+// hash_one / hash_many
+// -------------------------------------------------------------------------------------------------
+
+// Hash of one key. This is not `std::hash<basic_fixed_string>` (which hashes through
+// `std::basic_string_view` for heterogeneous lookup): a table must use one or the other for all
+// of its keys, e.g. `std::unordered_set<K, H>` with an `H` calling `hash_one`.
+MTP_EXPORT template <typename CharT, std::size_t N>
+[[nodiscard]] constexpr auto
+hash_one(basic_fixed_string<CharT, N> const& key, std::uint64_t seed = 0) noexcept -> std::uint64_t
+{
+  return detail::hash::one(key, seed, std::make_index_sequence<detail::hash::words<CharT, N>>{});
+}
+
+// Hashes `keys` into `out` (`out[i] == hash_one(keys[i], seed)`), `detail::hash::lanes` keys at a
+// time. With `threads` other than 1 (0 meaning the hardware concurrency), inputs large enough to
+// amortize thread start-up are split into contiguous ranges hashed in parallel.
+MTP_EXPORT template <typename CharT, std::size_t N>
+auto
+hash_many(std::span<basic_fixed_string<CharT, N> const> keys, std::span<std::uint64_t> out,
+          unsigned threads = 1, std::uint64_t seed = 0) -> void
+{
+  MTP_EXPECTS(out.size() >= keys.size());
+  constexpr std::size_t grain = std::size_t{ 1 } << 16;
+
+  if (threads == 0) {
+    threads = std::thread::hardware_concurrency();
+  }
+  auto const useful = keys.size() / grain;
+  if (threads > useful) {
+    threads = static_cast<unsigned>(useful);
+  }
+  if (threads <= 1) {
+    detail::hash::many(keys.data(), out.data(), keys.size(), seed);
+    return;
+  }
+
+  // ceil(size / threads) rounded up to the lane count: the chunks cover every key, and their
+  // boundaries stay multiples of the lane count so only the last chunk has a scalar tail
+  constexpr auto lanes = detail::hash::lanes;
+  auto const per = ((keys.size() + threads - 1) / threads + lanes - 1) / lanes * lanes;
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+  // joins the started workers on every exit, including a failed thread start
+  struct joiner
+  {
+    std::vector<std::thread>& pool;
+
+    ~joiner()
+    {
+      for (auto& th : pool) {
+        th.join();
+      }
+    }
+  } const join{ pool };
+  for (auto t = 1u; t < threads; ++t) {
+    auto const first = t * per;
+    if (first >= keys.size()) {
+      break;
+    }
+    auto const n = keys.size() - first < per ? keys.size() - first : per;
+    pool.emplace_back(
+      [=] { detail::hash::many(keys.data() + first, out.data() + first, n, seed); });
+  }
+  detail::hash::many(keys.data(), out.data(), per < keys.size() ? per : keys.size(), seed);
+}
+
+MTP_EXPORT template <typename CharT, std::size_t N>
+auto
+hash_many(std::span<basic_fixed_string<CharT, N>> keys, std::span<std::uint64_t> out,
+          unsigned threads = 1, std::uint64_t seed = 0) -> void
+{
+  hash_many(std::span<basic_fixed_string<CharT, N> const>{ keys }, out, threads, seed);
+}
+
+} // namespace mtp
+
+// -------------------------------------------------------------------------------------------------
+
+#undef MTP_EXPORT
+#undef MTP_EXPECTS
+#undef MTP_HASH_SSE2
+
+// -------------------------------------------------------------------------------------------------
+
+#endif // MTP_HASH_HPP
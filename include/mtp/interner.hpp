@@ -0,0 +1,344 @@
+#ifndef MTP_INTERNER_HPP
+#define MTP_INTERNER_HPP
+
+// -------------------------------------------------------------------------------------------------
+
+#include <mtp/fixed_string.hpp>
+
+// -------------------------------------------------------------------------------------------------
+
+#ifndef MTP_EXPORT
+#  define MTP_EXPORT
+#endif
+
+#ifndef MTP_EXPECTS
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    define MTP_EXPECTS(cond) __assume(cond)
+#  elif defined(__GNUC__) || defined(__clang__)
+#    define MTP_EXPECTS(cond) ((cond) ? static_cast<void>(0) : __builtin_unreachable())
+#  else
+#    define MTP_EXPECTS(cond)
+#  endif
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+#ifndef MTP_BUILD_MODULE
+#  include <atomic>
+#  include <cstddef>
+#  include <functional>
+#  include <memory>
+#  include <mutex>
+#  include <new>
+#  include <string_view>
+#  include <vector>
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+namespace mtp {
+
+// -------------------------------------------------------------------------------------------------
+// interned string handle
+// -------------------------------------------------------------------------------------------------
+
+namespace detail {
+
+// Arena record. The characters follow the header and are laid out like the `_data` member of a
+// `basic_fixed_string<CharT, size>` (size characters plus a terminating null).
+template <typename CharT>
+struct intern_record
+{
+  std::size_t hash;
+  std::size_t size;
+
+  [[nodiscard]] auto
+  data() const noexcept -> CharT const*
+  {
+    return reinterpret_cast<CharT const*>(this + 1);
+  }
+};
+
+} // namespace detail
+
+MTP_EXPORT template <typename CharT>
+class basic_interned
+{
+  using record = detail::intern_record<CharT>;
+
+  record const* _record = nullptr;
+
+  template <typename>
+  friend class basic_interner;
+
+  constexpr explicit basic_interned(record const* r) noexcept : _record{ r } {}
+
+public:
+  using value_type = CharT;
+  using size_type = std::size_t;
+
+  basic_interned() = default;
+
+  [[nodiscard]] auto
+  data() const noexcept -> CharT const*
+  {
+    MTP_EXPECTS(_record != nullptr);
+    return _record->data();
+  }
+
+  [[nodiscard]] auto
+  c_str() const noexcept -> CharT const*
+  {
+    return data();
+  }
+
+  [[nodiscard]] auto
+  size() const noexcept -> size_type
+  {
+    MTP_EXPECTS(_record != nullptr);
+    return _record->size;
+  }
+
+  [[nodiscard]] auto
+  hash() const noexcept -> std::size_t
+  {
+    MTP_EXPECTS(_record != nullptr);
+    return _record->hash;
+  }
+
+  [[nodiscard]] auto
+  view() const noexcept -> std::basic_string_view<CharT>
+  {
+    return { data(), size() };
+  }
+
+  template <std::size_t N>
+  [[nodiscard]] auto
+  to_fixed_string() const noexcept -> basic_fixed_string<CharT, N>
+  {
+    MTP_EXPECTS(size() == N);
+    return basic_fixed_string<CharT, N>{ data(), data() + N };
+  }
+
+  [[nodiscard]] explicit
+  operator bool() const noexcept
+  {
+    return _record != nullptr;
+  }
+
+  // interned strings are unique per interner, so identity is equality
+  [[nodiscard]] friend auto
+  operator==(basic_interned, basic_interned) noexcept -> bool = default;
+};
+
+MTP_EXPORT using interned = basic_interned<char>;
+
+// -------------------------------------------------------------------------------------------------
+// interner
+// -------------------------------------------------------------------------------------------------
+
+// Concurrent string interner. Lookups are lock-free: each shard publishes an open-addressing table
+// of atomic record pointers that is only ever appended to (slots go from null to a record once) or
+// replaced wholesale by a larger copy on growth. Inserts take the owning shard's lock. Records and
+// retired tables live until the interner is destroyed, so handles and concurrent readers never
+// observe freed memory.
+MTP_EXPORT template <typename CharT>
+class basic_interner
+{
+  using record = detail::intern_record<CharT>;
+
+  static constexpr std::size_t shard_count = 64;
+  static constexpr std::size_t initial_capacity = 64;
+  static constexpr std::size_t chunk_size = 64 * 1024;
+
+  struct table
+  {
+    std::size_t mask;
+    std::unique_ptr<std::atomic<record const*>[]> slots;
+
+    explicit table(std::size_t capacity)
+      : mask{ capacity - 1 }, slots{ new std::atomic<record const*>[capacity] }
+    {
+      for (auto i = 0u; i < capacity; ++i) {
+        slots[i].store(nullptr, std::memory_order_relaxed);
+      }
+    }
+
+    [[nodiscard]] auto
+    find(std::basic_string_view<CharT> str, std::size_t h) const noexcept -> record const*
+    {
+      for (auto i = h;; ++i) {
+        auto const* r = slots[i & mask].load(std::memory_order_acquire);
+        if (r == nullptr) {
+          return nullptr;
+        }
+        if (r->hash == h && std::basic_string_view<CharT>{ r->data(), r->size } == str) {
+          return r;
+        }
+      }
+    }
+
+    auto
+    insert(record const* r) noexcept -> void
+    {
+      auto i = r->hash;
+      while (slots[i & mask].load(std::memory_order_relaxed) != nullptr) {
+        ++i;
+      }
+      slots[i & mask].store(r, std::memory_order_release);
+    }
+  };
+
+  // one cache line per shard so uncontended shards do not false-share their lock
+  struct alignas(64) shard
+  {
+    std::atomic<table*> current{ nullptr };
+    std::mutex mutex;
+    std::size_t count = 0;
+    std::vector<std::unique_ptr<table>> tables;
+    std::vector<std::unique_ptr<std::byte[]>> chunks;
+    std::byte* bump = nullptr;
+    std::size_t remaining = 0;
+
+    shard()
+    {
+      tables.push_back(std::make_unique<table>(initial_capacity));
+      current.store(tables.back().get(), std::memory_order_release);
+    }
+
+    auto
+    allocate(std::size_t bytes) -> std::byte*
+    {
+      bytes = (bytes + alignof(record) - 1) & ~(alignof(record) - 1);
+      if (bytes > remaining) {
+        auto const size = bytes > chunk_size ? bytes : chunk_size;
+        chunks.push_back(std::make_unique<std::byte[]>(size));
+        bump = chunks.back().get();
+        remaining = size;
+      }
+      auto* p = bump;
+      bump += bytes;
+      remaining -= bytes;
+      return p;
+    }
+
+    auto
+    grow() -> void
+    {
+      auto const* old = current.load(std::memory_order_relaxed);
+      auto next = std::make_unique<table>((old->mask + 1) * 2);
+      for (auto i = 0u; i <= old->mask; ++i) {
+        if (auto const* r = old->slots[i].load(std::memory_order_relaxed)) {
+          next->insert(r);
+        }
+      }
+      tables.push_back(std::move(next));
+      current.store(tables.back().get(), std::memory_order_release);
+    }
+  };
+
+  std::unique_ptr<shard[]> _shards{ new shard[shard_count] };
+  std::atomic<std::size_t> _size{ 0 };
+
+  [[nodiscard]] static auto
+  hash_of(std::basic_string_view<CharT> str) noexcept -> std::size_t
+  {
+    return std::hash<std::basic_string_view<CharT>>{}(str);
+  }
+
+  [[nodiscard]] auto
+  shard_of(std::size_t h) const noexcept -> shard&
+  {
+    // high bits pick the shard, low bits the slot
+    return _shards[(h >> (sizeof(std::size_t) * 8 - 6)) % shard_count];
+  }
+
+public:
+  using value_type = CharT;
+  using handle = basic_interned<CharT>;
+
+  basic_interner() = default;
+  basic_interner(basic_interner const&) = delete;
+  basic_interner& operator=(basic_interner const&) = delete;
+
+  // Returns the handle of `str` if it has been interned. Never blocks.
+  [[nodiscard]] auto
+  find(std::basic_string_view<CharT> str) const noexcept -> handle
+  {
+    auto const h = hash_of(str);
+    auto const* t = shard_of(h).current.load(std::memory_order_acquire);
+    return handle{ t->find(str, h) };
+  }
+
+  // Returns the unique handle of `str`, copying it into the arena on first sight.
+  auto
+  intern(std::basic_string_view<CharT> str) -> handle
+  {
+    auto const h = hash_of(str);
+    auto& s = shard_of(h);
+    if (auto const* r = s.current.load(std::memory_order_acquire)->find(str, h)) {
+      return handle{ r };
+    }
+
+    auto lock = std::lock_guard{ s.mutex };
+    auto* t = s.current.load(std::memory_order_relaxed);
+    if (auto const* r = t->find(str, h)) {
+      return handle{ r };
+    }
+
+    auto* mem = s.allocate(sizeof(record) + (str.size() + 1) * sizeof(CharT));
+    auto* r = ::new (mem) record{ h, str.size() };
+    auto* chars = reinterpret_cast<CharT*>(r + 1);
+    str.copy(chars, str.size());
+    chars[str.size()] = CharT{};
+
+    if (2 * (s.count + 1) > t->mask + 1) {
+      s.grow();
+      t = s.current.load(std::memory_order_relaxed);
+    }
+    t->insert(r);
+    ++s.count;
+    _size.fetch_add(1, std::memory_order_relaxed);
+    return handle{ r };
+  }
+
+  template <std::size_t N>
+  auto
+  intern(basic_fixed_string<CharT, N> const& str) -> handle
+  {
+    return intern(str.view());
+  }
+
+  [[nodiscard]] auto
+  size() const noexcept -> std::size_t
+  {
+    return _size.load(std::memory_order_relaxed);
+  }
+};
+
+MTP_EXPORT using interner = basic_interner<char>;
+
+} // namespace mtp
+
+// -------------------------------------------------------------------------------------------------
+// hashing support
+// -------------------------------------------------------------------------------------------------
+
+MTP_EXPORT template <typename CharT>
+struct std::hash<mtp::basic_interned<CharT>>
+{
+  [[nodiscard]] auto
+  operator()(mtp::basic_interned<CharT> const& s) const noexcept -> std::size_t
+  {
+    return s ? s.hash() : 0;
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
+
+#undef MTP_EXPORT
+#undef MTP_EXPECTS
+
+// -------------------------------------------------------------------------------------------------
+
+#endif // MTP_INTERNER_HPP
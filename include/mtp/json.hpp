@@ -0,0 +1,389 @@
+#ifndef MTP_JSON_HPP
+#define MTP_JSON_HPP
+
+// -------------------------------------------------------------------------------------------------
+
+#include <mtp/fixed_string.hpp>
+
+// -------------------------------------------------------------------------------------------------
+
+#ifndef MTP_EXPORT
+#  define MTP_EXPORT
+#endif
+
+#ifndef MTP_EXPECTS
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    define MTP_EXPECTS(cond) __assume(cond)
+#  elif defined(__GNUC__) || defined(__clang__)
+#    define MTP_EXPECTS(cond) ((cond) ? static_cast<void>(0) : __builtin_unreachable())
+#  else
+#    define MTP_EXPECTS(cond)
+#  endif
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define MTP_JSON_SSE2
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+#ifndef MTP_BUILD_MODULE
+#  include <bit>
+#  include <charconv>
+#  include <cmath>
+#  include <concepts>
+#  include <cstddef>
+#  include <cstdint>
+#  include <string>
+#  include <string_view>
+#  include <system_error>
+#  include <type_traits>
+#endif
+#if defined(MTP_JSON_SSE2)
+#  include <emmintrin.h>
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+namespace mtp {
+
+// -------------------------------------------------------------------------------------------------
+// escaping
+// -------------------------------------------------------------------------------------------------
+
+namespace detail::json {
+
+// Escape sequence of a byte as "\\X" (short form) or "\\u00XX"; 0 for bytes that need none.
+[[nodiscard]] constexpr auto
+escape_of(unsigned char c) noexcept -> char
+{
+  switch (c) {
+    case '"': return '"';
+    case '\\': return '\\';
+    case '\b': return 'b';
+    case '\f': return 'f';
+    case '\n': return 'n';
+    case '\r': return 'r';
+    case '\t': return 't';
+    default: return c < 0x20 ? 'u' : '\0';
+  }
+}
+
+[[nodiscard]] constexpr auto
+escaped_size(std::string_view str) noexcept -> std::size_t
+{
+  std::size_t size = 0;
+  for (auto c : str) {
+    auto const e = escape_of(static_cast<unsigned char>(c));
+    size += e == '\0' ? 1 : e == 'u' ? 6 : 2;
+  }
+  return size;
+}
+
+// Writes the escape sequence of `c` (which needs one) to `out` and returns the end.
+constexpr auto
+escape_one(unsigned char c, char* out) noexcept -> char*
+{
+  constexpr char hex[] = "0123456789abcdef";
+  auto const e = escape_of(c);
+  *out++ = '\\';
+  *out++ = e;
+  if (e == 'u') {
+    *out++ = '0';
+    *out++ = '0';
+    *out++ = hex[c >> 4];
+    *out++ = hex[c & 0xF];
+  }
+  return out;
+}
+
+// `Str` escaped and quoted, plus `Suffix` (e.g. ':' for a key) when it is not '\0'.
+template <basic_fixed_string Str, char Suffix>
+[[nodiscard]] consteval auto
+quote() noexcept
+{
+  constexpr auto size = escaped_size(Str.view()) + 2 + (Suffix != '\0');
+  char buf[size + 1]{};
+  auto out = buf;
+  *out++ = '"';
+  for (auto c : Str) {
+    if (escape_of(static_cast<unsigned char>(c)) == '\0') {
+      *out++ = c;
+    } else {
+      out = escape_one(static_cast<unsigned char>(c), out);
+    }
+  }
+  *out++ = '"';
+  if constexpr (Suffix != '\0') {
+    *out++ = Suffix;
+  }
+  return basic_fixed_string<char, size>{ buf, buf + size };
+}
+
+} // namespace detail::json
+
+namespace json {
+
+// -------------------------------------------------------------------------------------------------
+// precomputed fragments
+// -------------------------------------------------------------------------------------------------
+
+MTP_EXPORT enum class key_mode { escape, strict };
+
+// The quoted, escaped string value `"Str"`.
+MTP_EXPORT template <basic_fixed_string Str>
+  requires(std::is_same_v<typename decltype(Str)::value_type, char>)
+inline constexpr auto quoted = detail::json::quote<Str, '\0'>();
+
+// The member key `"Name":`. With `key_mode::strict`, names that would need escaping are rejected
+// at compile time instead.
+MTP_EXPORT template <basic_fixed_string Name, key_mode Mode = key_mode::escape>
+  requires(std::is_same_v<typename decltype(Name)::value_type, char> &&
+           (Mode != key_mode::strict || detail::json::escaped_size(Name.view()) == Name.size()))
+inline constexpr auto key = detail::json::quote<Name, ':'>();
+
+// -------------------------------------------------------------------------------------------------
+// writer
+// -------------------------------------------------------------------------------------------------
+
+// Streams JSON into a reusable buffer. Keys and constant strings are spliced in as precomputed
+// fragments; runtime strings are escaped sixteen bytes at a time, copying clean runs in bulk. The
+// writer inserts commas but does not otherwise validate the document's structure.
+MTP_EXPORT class writer
+{
+  std::string _buf;
+  bool _comma = false;
+
+  auto
+  separate() -> void
+  {
+    if (_comma) {
+      _buf.push_back(',');
+    }
+    _comma = true;
+  }
+
+  // Length of the run at [first, last) free of bytes that need escaping.
+  [[nodiscard]] static auto
+  clean_run(char const* first, char const* last) noexcept -> std::size_t
+  {
+    auto p = first;
+#if defined(MTP_JSON_SSE2)
+    auto const quote = _mm_set1_epi8('"');
+    auto const backslash = _mm_set1_epi8('\\');
+    auto const control = _mm_set1_epi8(0x1F);
+    for (; last - p >= 16; p += 16) {
+      auto const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+      // unsigned v <= 0x1F  <=>  max(v, 0x1F) == 0x1F
+      auto const special = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+        _mm_cmpeq_epi8(_mm_max_epu8(v, control), control));
+      if (auto const m = static_cast<unsigned>(_mm_movemask_epi8(special)); m != 0) {
+        return static_cast<std::size_t>(p - first) + static_cast<std::size_t>(std::countr_zero(m));
+      }
+    }
+#endif
+    for (; p != last && detail::json::escape_of(static_cast<unsigned char>(*p)) == '\0'; ++p) {}
+    return static_cast<std::size_t>(p - first);
+  }
+
+  auto
+  escape(std::string_view str) -> void
+  {
+    auto p = str.data();
+    auto const last = p + str.size();
+    while (p != last) {
+      auto const n = clean_run(p, last);
+      _buf.append(p, n);
+      p += n;
+      if (p == last) {
+        break;
+      }
+      char seq[6];
+      _buf.append(seq, detail::json::escape_one(static_cast<unsigned char>(*p++), seq));
+    }
+  }
+
+public:
+  writer() = default;
+
+  explicit writer(std::size_t capacity)
+  {
+    _buf.reserve(capacity);
+  }
+
+  // Empties the document but keeps the buffer's capacity.
+  auto
+  clear() noexcept -> void
+  {
+    _buf.clear();
+    _comma = false;
+  }
+
+  [[nodiscard]] auto
+  view() const noexcept -> std::string_view
+  {
+    return _buf;
+  }
+
+  [[nodiscard]] auto
+  size() const noexcept -> std::size_t
+  {
+    return _buf.size();
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // structure
+  // -----------------------------------------------------------------------------------------------
+
+  auto
+  begin_object() -> writer&
+  {
+    separate();
+    _buf.push_back('{');
+    _comma = false;
+    return *this;
+  }
+
+  auto
+  end_object() -> writer&
+  {
+    _buf.push_back('}');
+    _comma = true;
+    return *this;
+  }
+
+  auto
+  begin_array() -> writer&
+  {
+    separate();
+    _buf.push_back('[');
+    _comma = false;
+    return *this;
+  }
+
+  auto
+  end_array() -> writer&
+  {
+    _buf.push_back(']');
+    _comma = true;
+    return *this;
+  }
+
+  template <basic_fixed_string Name, key_mode Mode = key_mode::escape>
+  auto
+  key() -> writer&
+  {
+    constexpr auto const& fragment = json::key<Name, Mode>;
+    separate();
+    _buf.append(fragment.data(), fragment.size());
+    _comma = false;
+    return *this;
+  }
+
+  // Runtime key, escaped like a string value.
+  auto
+  key(std::string_view name) -> writer&
+  {
+    value(name);
+    _buf.push_back(':');
+    _comma = false;
+    return *this;
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // values
+  // -----------------------------------------------------------------------------------------------
+
+  auto
+  value(std::string_view str) -> writer&
+  {
+    separate();
+    _buf.push_back('"');
+    escape(str);
+    _buf.push_back('"');
+    return *this;
+  }
+
+  // a null pointer is written as null
+  auto
+  value(char const* str) -> writer&
+  {
+    return str == nullptr ? value(nullptr) : value(std::string_view{ str });
+  }
+
+  // a character is a one-character string
+  auto
+  value(char c) -> writer&
+  {
+    return value(std::string_view{ &c, 1 });
+  }
+
+  template <basic_fixed_string Str>
+  auto
+  value() -> writer&
+  {
+    constexpr auto const& fragment = quoted<Str>;
+    separate();
+    _buf.append(fragment.data(), fragment.size());
+    return *this;
+  }
+
+  auto
+  value(bool b) -> writer&
+  {
+    separate();
+    _buf.append(b ? std::string_view{ "true" } : std::string_view{ "false" });
+    return *this;
+  }
+
+  auto
+  value(std::nullptr_t) -> writer&
+  {
+    separate();
+    _buf.append("null");
+    return *this;
+  }
+
+  template <typename T>
+    requires((std::integral<T> && !std::is_same_v<T, bool> && !concepts::char_type<T>) ||
+             std::floating_point<T>)
+  auto
+  value(T v) -> writer&
+  {
+    if constexpr (std::floating_point<T>) {
+      if (!std::isfinite(v)) {
+        return value(nullptr); // JSON has no NaN or infinity
+      }
+    }
+    separate();
+    char tmp[32];
+    auto const res = std::to_chars(tmp, tmp + sizeof(tmp), v);
+    MTP_EXPECTS(res.ec == std::errc{});
+    _buf.append(tmp, res.ptr);
+    return *this;
+  }
+
+  // key<Name>() followed by value(v)
+  template <basic_fixed_string Name, key_mode Mode = key_mode::escape, typename T>
+  auto
+  member(T const& v) -> writer&
+  {
+    key<Name, Mode>();
+    return value(v);
+  }
+};
+
+} // namespace json
+
+} // namespace mtp
+
+// -------------------------------------------------------------------------------------------------
+
+#undef MTP_EXPORT
+#undef MTP_EXPECTS
+#undef MTP_JSON_SSE2
+
+// -------------------------------------------------------------------------------------------------
+
+#endif // MTP_JSON_HPP
@@ -0,0 +1,823 @@
+#ifndef MTP_LOG_HPP
+#define MTP_LOG_HPP
+
+// -------------------------------------------------------------------------------------------------
+
+#include <mtp/fixed_string.hpp>
+
+// -------------------------------------------------------------------------------------------------
+
+#ifndef MTP_EXPORT
+#  define MTP_EXPORT
+#endif
+
+#if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+#  define MTP_THROW(except) throw except
+#else
+#  define MTP_THROW(except)
+#endif
+
+#if __has_cpp_attribute(unlikely)
+#  define MTP_UNLIKELY [[unlikely]]
+#else
+#  define MTP_UNLIKELY
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+#ifndef MTP_BUILD_MODULE
+#  include <atomic>
+#  include <charconv>
+#  include <chrono>
+#  include <cstddef>
+#  include <cstdint>
+#  include <cstdio>
+#  include <cstring>
+#  include <memory>
+#  include <mutex>
+#  include <span>
+#  if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+#    include <stdexcept>
+#  endif
+#  include <string>
+#  include <string_view>
+#  include <system_error>
+#  include <thread>
+#  include <type_traits>
+#  include <unordered_map>
+#  include <unordered_set>
+#  include <utility>
+#  include <vector>
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+namespace mtp {
+
+// -------------------------------------------------------------------------------------------------
+// wire format
+// -------------------------------------------------------------------------------------------------
+//
+// A log is a sequence of frames, each starting with an 8-byte header (total frame size, a multiple
+// of 8, and the frame kind):
+//
+//   record  u64 format id, then the arguments: 8 bytes for each bool, character, integer (widened
+//           to 64 bits), floating point value (as double) or pointer; a u32 length plus the bytes
+//           for each string
+//   format  u64 format id, u32 signature length, u32 format length, signature, format string
+//   thread  u32 index of the thread whose records follow
+//
+// The signature has one type code per argument (see `code_of`). In a thread's ring buffer the
+// record's id field holds the address of the format's descriptor instead; the backend emits a
+// format frame the first time it sees a descriptor and rewrites the field to the descriptor's id.
+
+namespace detail::log {
+
+enum class frame_kind : std::uint32_t
+{
+  record = 0,
+  format = 1,
+  thread = 2,
+  padding = 3,
+};
+
+struct frame_header
+{
+  std::uint32_t size;
+  frame_kind kind;
+};
+
+inline constexpr std::size_t header_size = sizeof(frame_header);
+
+// frame sizes and string lengths are 32-bit on the wire
+inline constexpr std::size_t max_frame_size = ~std::uint32_t{ 7 };
+
+[[nodiscard]] constexpr auto
+aligned(std::size_t n) noexcept -> std::size_t
+{
+  return (n + 7) & ~std::size_t{ 7 };
+}
+
+// Number of "{}" placeholders in `fmt` ("{{" and "}}" are literal braces), or -1 if malformed.
+[[nodiscard]] constexpr auto
+placeholders(std::string_view fmt) noexcept -> long
+{
+  long count = 0;
+  for (std::size_t i = 0; i < fmt.size(); ++i) {
+    if (fmt[i] == '{' || fmt[i] == '}') {
+      if (i + 1 == fmt.size()) {
+        return -1;
+      }
+      if (fmt[i] == '{' && fmt[i + 1] == '}') {
+        ++count;
+      } else if (fmt[i + 1] != fmt[i]) {
+        return -1;
+      }
+      ++i;
+    }
+  }
+  return count;
+}
+
+[[nodiscard]] constexpr auto
+fnv1a(std::uint64_t h, std::string_view str) noexcept -> std::uint64_t
+{
+  for (auto c : str) {
+    h = (h ^ static_cast<unsigned char>(c)) * 0x100000001B3u;
+  }
+  return h;
+}
+
+template <typename T>
+concept string_like = std::is_convertible_v<T const&, std::string_view> ||
+                      requires(T const& v) {
+                        { v.view() } -> std::same_as<std::string_view>;
+                      };
+
+// type code of an argument; '\0' for types that cannot be logged
+template <typename T>
+[[nodiscard]] consteval auto
+code_of() noexcept -> char
+{
+  using U = std::remove_cvref_t<T>;
+  if constexpr (std::is_same_v<U, bool>) {
+    return 'b';
+  } else if constexpr (std::is_same_v<U, char>) {
+    return 'c';
+  } else if constexpr (std::is_integral_v<U>) {
+    return std::is_signed_v<U> ? 'i' : 'u';
+  } else if constexpr (std::is_floating_point_v<U>) {
+    return 'd';
+  } else if constexpr (string_like<std::decay_t<U>>) {
+    return 's';
+  } else if constexpr (std::is_pointer_v<std::decay_t<U>>) {
+    return 'p';
+  } else {
+    return '\0';
+  }
+}
+
+struct descriptor
+{
+  std::uint64_t id;
+  std::string_view format;
+  std::string_view signature;
+};
+
+template <char... Sig>
+inline constexpr char signature[] = { Sig..., '\0' };
+
+// One descriptor per (format, signature); its address is what the hot path records.
+template <basic_fixed_string Fmt, char... Sig>
+inline constexpr descriptor descriptor_of{
+  fnv1a(fnv1a(0xCBF29CE484222325u, Fmt.view()) ^ 0xFF, std::string_view{ signature<Sig...> }),
+  Fmt.view(),
+  std::string_view{ signature<Sig...> },
+};
+
+// a null C string is recorded as an empty string
+template <typename T>
+[[nodiscard]] auto
+string_of(T const& v) noexcept -> std::string_view
+{
+  if constexpr (std::is_pointer_v<T>) {
+    return v == nullptr ? std::string_view{} : std::string_view{ v };
+  } else if constexpr (std::is_convertible_v<T const&, std::string_view>) {
+    return v;
+  } else {
+    return v.view();
+  }
+}
+
+template <typename T>
+[[nodiscard]] auto
+arg_size(T const& v) noexcept -> std::size_t
+{
+  if constexpr (code_of<T>() == 's') {
+    return 4 + string_of(v).size();
+  } else {
+    return 8;
+  }
+}
+
+template <typename T>
+auto
+put(std::byte* p, T const& v) noexcept -> std::byte*
+{
+  constexpr auto code = code_of<T>();
+  if constexpr (code == 's') {
+    auto const str = string_of(v);
+    auto const n = static_cast<std::uint32_t>(str.size());
+    std::memcpy(p, &n, 4);
+    std::memcpy(p + 4, str.data(), n);
+    return p + 4 + n;
+  } else {
+    if constexpr (code == 'd') {
+      auto const x = static_cast<double>(v);
+      std::memcpy(p, &x, 8);
+    } else if constexpr (code == 'p') {
+      auto const x = reinterpret_cast<std::uintptr_t>(v);
+      std::uint64_t const w = x;
+      std::memcpy(p, &w, 8);
+    } else if constexpr (code == 'i') {
+      auto const x = static_cast<std::int64_t>(v);
+      std::memcpy(p, &x, 8);
+    } else {
+      auto const x = static_cast<std::uint64_t>(v);
+      std::memcpy(p, &x, 8);
+    }
+    return p + 8;
+  }
+}
+
+// ---------------------------------------------------------------------------------------------
+// per-thread ring
+// ---------------------------------------------------------------------------------------------
+
+// Single-producer single-consumer ring of frames. A frame never wraps: when it does not fit before
+// the end of the buffer, the producer fills the rest with a padding frame and starts over at 0.
+class ring
+{
+  std::unique_ptr<std::byte[]> _buf;
+  std::size_t _capacity;
+  std::uint32_t _thread;
+
+  alignas(64) std::atomic<std::size_t> _head{ 0 };
+  std::size_t _cached_tail = 0;
+  std::size_t _next = 0;
+  std::uint64_t _dropped = 0;
+
+  alignas(64) std::atomic<std::size_t> _tail{ 0 };
+  std::atomic<std::uint64_t> _dropped_seen{ 0 };
+  std::atomic<bool> _retired{ false };
+
+  [[nodiscard]] auto
+  fits(std::size_t head, std::size_t size) noexcept -> bool
+  {
+    if (head + size - _cached_tail <= _capacity) {
+      return true;
+    }
+    _cached_tail = _tail.load(std::memory_order_acquire);
+    return head + size - _cached_tail <= _capacity;
+  }
+
+public:
+  // the buffer is zeroed so its pages are faulted in here rather than on the logging path
+  ring(std::size_t capacity, std::uint32_t thread)
+    : _buf{ new std::byte[capacity]{} }, _capacity{ capacity }, _thread{ thread }
+  {}
+
+  [[nodiscard]] auto
+  thread() const noexcept -> std::uint32_t
+  {
+    return _thread;
+  }
+
+  // producer: `size` (a multiple of 8) contiguous bytes, or nullptr if the ring is full
+  [[nodiscard]] auto
+  reserve(std::size_t size) noexcept -> std::byte*
+  {
+    auto head = _head.load(std::memory_order_relaxed);
+    if (auto const contiguous = _capacity - (head & (_capacity - 1)); size > contiguous) {
+      // pad out the end of the buffer; the padding is published on its own so that the space it
+      // covers is freed as soon as the consumer passes it
+      if (!fits(head, contiguous)) {
+        return drop();
+      }
+      auto const pad = frame_header{ static_cast<std::uint32_t>(contiguous), frame_kind::padding };
+      std::memcpy(_buf.get() + (head & (_capacity - 1)), &pad, header_size);
+      head += contiguous;
+      _head.store(head, std::memory_order_release);
+    }
+    if (!fits(head, size)) {
+      return drop();
+    }
+    _next = head + size;
+    return _buf.get() + (head & (_capacity - 1));
+  }
+
+  // producer: counts a record that is not written; always nullptr
+  auto
+  drop() noexcept -> std::byte*
+  {
+    _dropped_seen.store(++_dropped, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  // producer: publishes the frame written after the last `reserve`
+  auto
+  commit() noexcept -> void
+  {
+    _head.store(_next, std::memory_order_release);
+  }
+
+  auto
+  retire() noexcept -> void
+  {
+    _retired.store(true, std::memory_order_release);
+  }
+
+  [[nodiscard]] auto
+  retired() const noexcept -> bool
+  {
+    return _retired.load(std::memory_order_acquire);
+  }
+
+  [[nodiscard]] auto
+  dropped() const noexcept -> std::uint64_t
+  {
+    return _dropped_seen.load(std::memory_order_relaxed);
+  }
+
+  // consumer: calls `f(frame)` for every published frame and then releases them; returns whether
+  // any frame was consumed
+  template <typename F>
+  auto
+  drain(F&& f) -> bool
+  {
+    auto tail = _tail.load(std::memory_order_relaxed);
+    auto const head = _head.load(std::memory_order_acquire);
+    if (tail == head) {
+      return false;
+    }
+    while (tail != head) {
+      auto const* p = _buf.get() + (tail & (_capacity - 1));
+      frame_header h;
+      std::memcpy(&h, p, header_size);
+      if (h.kind != frame_kind::padding) {
+        f(std::span<std::byte const>{ p, h.size });
+      }
+      tail += h.size;
+    }
+    _tail.store(tail, std::memory_order_release);
+    return true;
+  }
+};
+
+} // namespace detail::log
+
+// -------------------------------------------------------------------------------------------------
+// backend
+// -------------------------------------------------------------------------------------------------
+
+// Owns the per-thread rings and turns their contents into the binary log, either on demand
+// (`poll`) or from a background thread (`start` / `stop`). Records of one thread stay in order;
+// records of different threads are interleaved in drain order, separated by thread frames.
+MTP_EXPORT class log_backend
+{
+  std::mutex _rings_mutex;
+  std::vector<std::shared_ptr<detail::log::ring>> _rings;
+  std::size_t _ring_capacity = std::size_t{ 1 } << 20;
+  std::uint32_t _next_thread = 0;
+  std::uint64_t _released_dropped = 0;
+
+  std::mutex _poll_mutex;
+  std::unordered_set<detail::log::descriptor const*> _known;
+  std::vector<std::byte> _out;
+
+  std::thread _worker;
+  std::atomic<bool> _stop{ false };
+
+  auto
+  append(void const* p, std::size_t n) -> void
+  {
+    auto const* b = static_cast<std::byte const*>(p);
+    _out.insert(_out.end(), b, b + n);
+  }
+
+  auto
+  append_frame(detail::log::frame_kind kind, std::size_t payload) -> std::size_t
+  {
+    auto const start = _out.size();
+    auto const size = detail::log::aligned(detail::log::header_size + payload);
+    _out.resize(start + size);
+    auto const h = detail::log::frame_header{ static_cast<std::uint32_t>(size), kind };
+    std::memcpy(_out.data() + start, &h, detail::log::header_size);
+    return start + detail::log::header_size;
+  }
+
+  auto
+  append_record(std::span<std::byte const> frame) -> void
+  {
+    detail::log::descriptor const* d;
+    std::memcpy(&d, frame.data() + detail::log::header_size, sizeof(d));
+    if (_known.insert(d).second) {
+      auto at = append_frame(detail::log::frame_kind::format,
+                             16 + d->signature.size() + d->format.size());
+      auto const sig = static_cast<std::uint32_t>(d->signature.size());
+      auto const fmt = static_cast<std::uint32_t>(d->format.size());
+      std::memcpy(_out.data() + at, &d->id, 8);
+      std::memcpy(_out.data() + at + 8, &sig, 4);
+      std::memcpy(_out.data() + at + 12, &fmt, 4);
+      std::memcpy(_out.data() + at + 16, d->signature.data(), sig);
+      std::memcpy(_out.data() + at + 16 + sig, d->format.data(), fmt);
+    }
+    auto const start = _out.size();
+    append(frame.data(), frame.size());
+    std::memcpy(_out.data() + start + detail::log::header_size, &d->id, 8);
+  }
+
+public:
+  log_backend() = default;
+  log_backend(log_backend const&) = delete;
+  log_backend& operator=(log_backend const&) = delete;
+
+  ~log_backend()
+  {
+    stop();
+  }
+
+  // The process-wide backend used by `mtp::log`.
+  [[nodiscard]] static auto
+  instance() -> log_backend&
+  {
+    static log_backend backend;
+    return backend;
+  }
+
+  // Size in bytes (rounded up to a power of two) of the rings of threads that log for the first
+  // time after this call.
+  auto
+  set_ring_capacity(std::size_t bytes) -> void
+  {
+    auto lock = std::lock_guard{ _rings_mutex };
+    std::size_t capacity = 64;
+    while (capacity < bytes) {
+      capacity *= 2;
+    }
+    _ring_capacity = capacity;
+  }
+
+  [[nodiscard]] auto
+  attach() -> std::shared_ptr<detail::log::ring>
+  {
+    auto lock = std::lock_guard{ _rings_mutex };
+    _rings.push_back(std::make_shared<detail::log::ring>(_ring_capacity, _next_thread++));
+    return _rings.back();
+  }
+
+  // Number of records dropped because a ring was full.
+  [[nodiscard]] auto
+  dropped() -> std::uint64_t
+  {
+    auto lock = std::lock_guard{ _rings_mutex };
+    auto n = _released_dropped;
+    for (auto const& r : _rings) {
+      n += r->dropped();
+    }
+    return n;
+  }
+
+  // Drains every ring once and passes the resulting binary log to `write(std::span<std::byte
+  // const>)` in one piece. Rings of exited threads are released once empty.
+  template <typename F>
+    requires(std::is_invocable_v<F&, std::span<std::byte const>>)
+  auto
+  poll(F&& write) -> std::size_t
+  {
+    auto poll_lock = std::lock_guard{ _poll_mutex };
+    std::vector<std::shared_ptr<detail::log::ring>> rings;
+    {
+      auto lock = std::lock_guard{ _rings_mutex };
+      rings = _rings;
+    }
+
+    _out.clear();
+    std::size_t records = 0;
+    for (auto const& r : rings) {
+      auto const retired = r->retired();
+      auto const mark = _out.size();
+      auto const at = append_frame(detail::log::frame_kind::thread, 4);
+      auto const thread = r->thread();
+      std::memcpy(_out.data() + at, &thread, 4);
+      auto const any = r->drain([&](std::span<std::byte const> frame) {
+        append_record(frame);
+        ++records;
+      });
+      if (!any) {
+        _out.resize(mark);
+        if (retired) {
+          auto lock = std::lock_guard{ _rings_mutex };
+          _released_dropped += r->dropped();
+          std::erase(_rings, r);
+        }
+      }
+    }
+    if (!_out.empty()) {
+      write(std::span<std::byte const>{ _out });
+    }
+    return records;
+  }
+
+  auto
+  poll(std::FILE* out) -> std::size_t
+  {
+    return poll([&](std::span<std::byte const> bytes) {
+      std::fwrite(bytes.data(), 1, bytes.size(), out);
+    });
+  }
+
+  // Starts a thread that polls into `out` every `period`.
+  auto
+  start(std::FILE* out, std::chrono::microseconds period = std::chrono::milliseconds{ 1 }) -> void
+  {
+    stop();
+    _stop.store(false, std::memory_order_relaxed);
+    _worker = std::thread{ [this, out, period] {
+      while (!_stop.load(std::memory_order_relaxed)) {
+        if (poll(out) == 0) {
+          std::this_thread::sleep_for(period);
+        }
+      }
+      poll(out);
+      std::fflush(out);
+    } };
+  }
+
+  // Stops the background thread after a final poll.
+  auto
+  stop() -> void
+  {
+    if (_worker.joinable()) {
+      _stop.store(true, std::memory_order_relaxed);
+      _worker.join();
+    }
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
+// front end
+// -------------------------------------------------------------------------------------------------
+
+namespace detail::log {
+
+inline thread_local ring* this_thread_ring = nullptr;
+
+// set once the calling thread's ring is retired; later records (e.g. from other thread_local
+// destructors) are dropped
+inline thread_local bool this_thread_retired = false;
+
+// Attaches the calling thread to the backend, or returns nullptr once its ring is retired. The
+// ring is retired when the thread exits.
+[[nodiscard]] inline auto
+attach_this_thread() -> ring*
+{
+  struct holder
+  {
+    std::shared_ptr<ring> r = log_backend::instance().attach();
+
+    ~holder()
+    {
+      r->retire();
+      this_thread_ring = nullptr;
+      this_thread_retired = true;
+    }
+  };
+  if (this_thread_retired) {
+    return nullptr;
+  }
+  thread_local holder h;
+  this_thread_ring = h.r.get();
+  return this_thread_ring;
+}
+
+} // namespace detail::log
+
+// Records `Fmt` and `args` for deferred formatting. Only the format's descriptor address and the
+// raw argument bytes are copied into the calling thread's ring; when the ring is full, or the
+// record would be 4 GiB or more, the record is dropped (and counted) rather than blocking.
+// Placeholders are "{}", with "{{" and "}}" for literal braces. A thread's first call allocates
+// its ring and may throw `std::bad_alloc`; later calls never throw.
+MTP_EXPORT template <basic_fixed_string Fmt, typename... Args>
+  requires(std::is_same_v<typename decltype(Fmt)::value_type, char> &&
+           detail::log::placeholders(Fmt.view()) == static_cast<long>(sizeof...(Args)) &&
+           ((detail::log::code_of<Args>() != '\0') && ...))
+auto
+log(Args const&... args) -> void
+{
+  static_assert(Fmt.size() < detail::log::max_frame_size / 2, "mtp::log: format too long");
+  constexpr auto* desc = &detail::log::descriptor_of<Fmt, detail::log::code_of<Args>()...>;
+
+  auto* r = detail::log::this_thread_ring;
+  if (r == nullptr)
+    MTP_UNLIKELY
+    {
+      r = detail::log::attach_this_thread();
+      if (r == nullptr) {
+        return;
+      }
+    }
+
+  auto const payload = 8 + (std::size_t{ 0 } + ... + detail::log::arg_size(args));
+  auto const size = detail::log::aligned(detail::log::header_size + payload);
+  if (size > detail::log::max_frame_size)
+    MTP_UNLIKELY
+    {
+      r->drop();
+      return;
+    }
+  auto* p = r->reserve(size);
+  if (p == nullptr) {
+    return;
+  }
+  auto const h = detail::log::frame_header{ static_cast<std::uint32_t>(size),
+                                            detail::log::frame_kind::record };
+  std::memcpy(p, &h, detail::log::header_size);
+  std::memcpy(p + detail::log::header_size, &desc, sizeof(desc));
+  [[maybe_unused]] auto* q = p + detail::log::header_size + 8;
+  ((q = detail::log::put(q, args)), ...);
+  r->commit();
+}
+
+// -------------------------------------------------------------------------------------------------
+// decoder
+// -------------------------------------------------------------------------------------------------
+
+// Turns a binary log back into text. Input may arrive in arbitrary pieces; incomplete frames are
+// kept until the rest arrives.
+MTP_EXPORT class log_decoder
+{
+  struct format
+  {
+    std::string signature;
+    std::string text;
+  };
+
+  std::unordered_map<std::uint64_t, format> _formats;
+  std::vector<std::byte> _pending;
+  std::uint32_t _thread = 0;
+  std::string _line;
+
+  template <typename T>
+  [[nodiscard]] static auto
+  read(std::byte const* p) noexcept -> T
+  {
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+    return v;
+  }
+
+  auto
+  append_number(auto v, int base = 10) -> void
+  {
+    char tmp[32];
+    std::to_chars_result res;
+    if constexpr (std::is_floating_point_v<decltype(v)>) {
+      res = std::to_chars(tmp, tmp + sizeof(tmp), v);
+    } else {
+      res = std::to_chars(tmp, tmp + sizeof(tmp), v, base);
+    }
+    _line.append(tmp, res.ptr);
+  }
+
+  // formats one record into `_line`; false if the record does not match its format
+  [[nodiscard]] auto
+  render(format const& f, std::byte const* p, std::byte const* last) -> bool
+  {
+    _line.clear();
+    std::size_t arg = 0;
+    auto const& text = f.text;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+      if (text[i] != '{' && text[i] != '}') {
+        _line.push_back(text[i]);
+        continue;
+      }
+      if (i + 1 == text.size()) {
+        return false;
+      }
+      if (text[i] == '}' || text[i + 1] == '{') {
+        _line.push_back(text[i++]);
+        continue;
+      }
+      ++i;
+      if (arg == f.signature.size()) {
+        return false;
+      }
+      auto const code = f.signature[arg++];
+      if (code == 's') {
+        if (last - p < 4) {
+          return false;
+        }
+        auto const n = read<std::uint32_t>(p);
+        if (static_cast<std::size_t>(last - p - 4) < n) {
+          return false;
+        }
+        _line.append(reinterpret_cast<char const*>(p + 4), n);
+        p += 4 + n;
+        continue;
+      }
+      if (last - p < 8) {
+        return false;
+      }
+      switch (code) {
+        case 'b': _line.append(read<std::uint64_t>(p) != 0 ? "true" : "false"); break;
+        case 'c': _line.push_back(static_cast<char>(read<std::uint64_t>(p))); break;
+        case 'i': append_number(read<std::int64_t>(p)); break;
+        case 'u': append_number(read<std::uint64_t>(p)); break;
+        case 'd': append_number(read<double>(p)); break;
+        case 'p':
+          _line.append("0x");
+          append_number(read<std::uint64_t>(p), 16);
+          break;
+        default: return false;
+      }
+      p += 8;
+    }
+    return arg == f.signature.size();
+  }
+
+  // handles one complete frame
+  template <typename F>
+  auto
+  frame(std::byte const* p, std::size_t size, F& f, std::errc& ec) -> void
+  {
+    auto const kind = read<detail::log::frame_header>(p).kind;
+    auto const* body = p + detail::log::header_size;
+    auto const* last = p + size;
+    if (kind == detail::log::frame_kind::thread && size >= 12) {
+      _thread = read<std::uint32_t>(body);
+    } else if (kind == detail::log::frame_kind::format && size >= 24) {
+      auto const sig = read<std::uint32_t>(body + 8);
+      auto const fmt = read<std::uint32_t>(body + 12);
+      if (std::size_t{ 16 } + sig + fmt > static_cast<std::size_t>(last - body)) {
+        ec = std::errc::illegal_byte_sequence;
+        return;
+      }
+      auto const* chars = reinterpret_cast<char const*>(body + 16);
+      _formats[read<std::uint64_t>(body)] =
+        format{ std::string{ chars, sig }, std::string{ chars + sig, fmt } };
+    } else if (kind == detail::log::frame_kind::record && size >= 16) {
+      auto const it = _formats.find(read<std::uint64_t>(body));
+      if (it == _formats.end() || !render(it->second, body + 8, last)) {
+        ec = std::errc::illegal_byte_sequence;
+        return;
+      }
+      f(_thread, std::string_view{ _line });
+    } else {
+      ec = std::errc::illegal_byte_sequence;
+    }
+  }
+
+public:
+  // Decodes `bytes`, calling `f(thread, line)` for every record. `ec` is set to
+  // `std::errc::illegal_byte_sequence` on malformed input (or a record whose format is unknown),
+  // which stops decoding.
+  template <typename F>
+    requires(std::is_invocable_v<F&, std::uint32_t, std::string_view>)
+  auto
+  feed(std::span<std::byte const> bytes, F&& f, std::errc& ec) -> void
+  {
+    ec = std::errc{};
+    _pending.insert(_pending.end(), bytes.begin(), bytes.end());
+    std::size_t at = 0;
+    while (_pending.size() - at >= detail::log::header_size) {
+      auto const h = read<detail::log::frame_header>(_pending.data() + at);
+      if (h.size < detail::log::header_size || h.size % 8 != 0) {
+        ec = std::errc::illegal_byte_sequence;
+        break;
+      }
+      if (_pending.size() - at < h.size) {
+        break;
+      }
+      frame(_pending.data() + at, h.size, f, ec);
+      if (ec != std::errc{}) {
+        break;
+      }
+      at += h.size;
+    }
+    _pending.erase(_pending.begin(), _pending.begin() + static_cast<std::ptrdiff_t>(at));
+  }
+
+  template <typename F>
+    requires(std::is_invocable_v<F&, std::uint32_t, std::string_view>)
+  auto
+  feed(std::span<std::byte const> bytes, F&& f) -> void
+  {
+    std::errc ec{};
+    feed(bytes, f, ec);
+    if (ec != std::errc{})
+      MTP_UNLIKELY
+      {
+        MTP_THROW(std::invalid_argument("mtp::log_decoder::feed"));
+      }
+  }
+
+  // Whether all input so far ended on a frame boundary.
+  [[nodiscard]] auto
+  complete() const noexcept -> bool
+  {
+    return _pending.empty();
+  }
+};
+
+} // namespace mtp
+
+// -------------------------------------------------------------------------------------------------
+
+#undef MTP_EXPORT
+#undef MTP_THROW
+#undef MTP_UNLIKELY
+
+// -------------------------------------------------------------------------------------------------
+
+#endif // MTP_LOG_HPP
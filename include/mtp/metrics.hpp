@@ -0,0 +1,402 @@
+#ifndef MTP_METRICS_HPP
+#define MTP_METRICS_HPP
+
+// -------------------------------------------------------------------------------------------------
+
+#include <mtp/fixed_string.hpp>
+
+// -------------------------------------------------------------------------------------------------
+
+#ifndef MTP_EXPORT
+#  define MTP_EXPORT
+#endif
+
+#if __has_cpp_attribute(unlikely)
+#  define MTP_UNLIKELY [[unlikely]]
+#else
+#  define MTP_UNLIKELY
+#endif
+
+// Number of 64-bit cells available to metrics in each thread's shard; a counter takes one cell, a
+// histogram `histogram<Name>::cells`. Metrics that do not fit are counted, not collected.
+#ifndef MTP_METRICS_MAX_CELLS
+#  define MTP_METRICS_MAX_CELLS 4096
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+#ifndef MTP_BUILD_MODULE
+#  include <atomic>
+#  include <bit>
+#  include <charconv>
+#  include <cstddef>
+#  include <cstdint>
+#  include <memory>
+#  include <mutex>
+#  include <string>
+#  include <string_view>
+#  include <type_traits>
+#  include <vector>
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+namespace mtp {
+
+// -------------------------------------------------------------------------------------------------
+// shards
+// -------------------------------------------------------------------------------------------------
+//
+// Every metric owns a dense range of cells, assigned once per process when the metric is first
+// used. Each thread writes only to its own shard (a cache-line aligned block holding every cell),
+// so updates are a plain load and store with no locking or read-modify-write; the collector sums
+// the shards with relaxed loads.
+
+namespace detail::metrics {
+
+inline constexpr std::size_t max_cells = MTP_METRICS_MAX_CELLS;
+
+// histogram layout: bucket b counts values of bit width b (0 for 0, 1 for 1, 2 for 2-3, ...,
+// 64 for values >= 2^63), followed by the running sum
+inline constexpr std::size_t histogram_buckets = 65;
+inline constexpr std::size_t histogram_cells = histogram_buckets + 1;
+
+// metrics that do not fit all write to one spare range past `max_cells`, which is never collected
+inline constexpr std::size_t sink = max_cells;
+
+enum class kind
+{
+  counter,
+  histogram,
+};
+
+struct alignas(64) shard
+{
+  std::atomic<std::uint64_t> cells[max_cells + histogram_cells]{};
+};
+
+inline auto
+bump(std::atomic<std::uint64_t>& cell, std::uint64_t n) noexcept -> void
+{
+  // single writer: no read-modify-write needed
+  cell.store(cell.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+} // namespace detail::metrics
+
+// -------------------------------------------------------------------------------------------------
+// snapshot
+// -------------------------------------------------------------------------------------------------
+
+MTP_EXPORT struct counter_value
+{
+  std::string name;
+  std::uint64_t value = 0;
+};
+
+MTP_EXPORT struct histogram_value
+{
+  std::string name;
+  std::uint64_t count = 0;
+  std::uint64_t sum = 0;
+  std::uint64_t buckets[detail::metrics::histogram_buckets]{};
+
+  // Upper bound of the bucket holding the `q` quantile (0 <= q <= 1); 0 when empty.
+  [[nodiscard]] auto
+  quantile(double q) const noexcept -> std::uint64_t
+  {
+    if (count == 0) {
+      return 0;
+    }
+    auto const rank = static_cast<std::uint64_t>(q * static_cast<double>(count - 1)) + 1;
+    std::uint64_t seen = 0;
+    for (auto b = 0u; b < detail::metrics::histogram_buckets; ++b) {
+      seen += buckets[b];
+      if (seen >= rank) {
+        return b == 64 ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << b) - 1;
+      }
+    }
+    return ~std::uint64_t{ 0 };
+  }
+};
+
+MTP_EXPORT struct metrics_snapshot
+{
+  std::vector<counter_value> counters;
+  std::vector<histogram_value> histograms;
+
+  [[nodiscard]] auto
+  counter(std::string_view name) const noexcept -> counter_value const*
+  {
+    for (auto const& c : counters) {
+      if (c.name == name) {
+        return &c;
+      }
+    }
+    return nullptr;
+  }
+
+  [[nodiscard]] auto
+  histogram(std::string_view name) const noexcept -> histogram_value const*
+  {
+    for (auto const& h : histograms) {
+      if (h.name == name) {
+        return &h;
+      }
+    }
+    return nullptr;
+  }
+
+  // One "name value" line per counter; count, sum and p50/p90/p99/max bucket bounds per histogram.
+  [[nodiscard]] auto
+  text() const -> std::string
+  {
+    std::string out;
+    auto line = [&](std::string_view name, std::string_view suffix, std::uint64_t v) {
+      char tmp[24];
+      out.append(name).append(suffix).push_back(' ');
+      out.append(tmp, std::to_chars(tmp, tmp + sizeof(tmp), v).ptr).push_back('\n');
+    };
+    for (auto const& c : counters) {
+      line(c.name, "", c.value);
+    }
+    for (auto const& h : histograms) {
+      line(h.name, ".count", h.count);
+      line(h.name, ".sum", h.sum);
+      line(h.name, ".p50", h.quantile(0.5));
+      line(h.name, ".p90", h.quantile(0.9));
+      line(h.name, ".p99", h.quantile(0.99));
+      line(h.name, ".max", h.quantile(1.0));
+    }
+    return out;
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
+// registry
+// -------------------------------------------------------------------------------------------------
+
+// Assigns cell ranges to metrics, tracks the shards of live threads, and aggregates them on
+// demand. The cells of an exiting thread are folded into a retired total.
+MTP_EXPORT class metrics_registry
+{
+  struct metric
+  {
+    std::string_view name;
+    detail::metrics::kind kind;
+    std::size_t first;
+  };
+
+  mutable std::mutex _mutex;
+  std::vector<metric> _metrics;
+  std::size_t _used = 0;
+  std::size_t _rejected = 0;
+  std::vector<detail::metrics::shard*> _shards;
+  std::unique_ptr<std::uint64_t[]> _retired{ new std::uint64_t[detail::metrics::max_cells]{} };
+
+public:
+  metrics_registry() = default;
+  metrics_registry(metrics_registry const&) = delete;
+  metrics_registry& operator=(metrics_registry const&) = delete;
+
+  // The process-wide registry used by `mtp::counter` and `mtp::histogram`.
+  [[nodiscard]] static auto
+  instance() -> metrics_registry&
+  {
+    static metrics_registry registry;
+    return registry;
+  }
+
+  // Returns the first cell of the metric `name`. Adding a name again with the same kind returns
+  // its existing cells. A metric whose name is taken by the other kind, or that no longer fits, is
+  // counted in `rejected()` and gets the spare range, so its updates are never collected.
+  auto
+  add(std::string_view name, detail::metrics::kind kind) -> std::size_t
+  {
+    auto lock = std::lock_guard{ _mutex };
+    for (auto const& m : _metrics) {
+      if (m.name == name) {
+        if (m.kind == kind) {
+          return m.first;
+        }
+        ++_rejected;
+        return detail::metrics::sink;
+      }
+    }
+    auto const cells =
+      kind == detail::metrics::kind::counter ? std::size_t{ 1 } : detail::metrics::histogram_cells;
+    if (_used + cells > detail::metrics::max_cells)
+      MTP_UNLIKELY
+      {
+        ++_rejected;
+        return detail::metrics::sink;
+      }
+    _metrics.push_back(metric{ name, kind, _used });
+    _used += cells;
+    return _metrics.back().first;
+  }
+
+  // Number of metrics left out of snapshots.
+  [[nodiscard]] auto
+  rejected() const -> std::size_t
+  {
+    auto lock = std::lock_guard{ _mutex };
+    return _rejected;
+  }
+
+  auto
+  attach(detail::metrics::shard* s) -> void
+  {
+    auto lock = std::lock_guard{ _mutex };
+    _shards.push_back(s);
+  }
+
+  auto
+  detach(detail::metrics::shard* s) -> void
+  {
+    auto lock = std::lock_guard{ _mutex };
+    for (auto i = 0u; i < _used; ++i) {
+      _retired[i] += s->cells[i].load(std::memory_order_relaxed);
+    }
+    std::erase(_shards, s);
+  }
+
+  // Sums every shard. Concurrent updates may or may not be included.
+  [[nodiscard]] auto
+  collect() const -> metrics_snapshot
+  {
+    auto lock = std::lock_guard{ _mutex };
+    auto const cell = [&](std::size_t i) {
+      auto v = _retired[i];
+      for (auto const* s : _shards) {
+        v += s->cells[i].load(std::memory_order_relaxed);
+      }
+      return v;
+    };
+
+    metrics_snapshot snap;
+    for (auto const& m : _metrics) {
+      if (m.kind == detail::metrics::kind::counter) {
+        snap.counters.push_back(counter_value{ std::string{ m.name }, cell(m.first) });
+        continue;
+      }
+      auto& h = snap.histograms.emplace_back();
+      h.name = m.name;
+      for (auto b = 0u; b < detail::metrics::histogram_buckets; ++b) {
+        h.buckets[b] = cell(m.first + b);
+        h.count += h.buckets[b];
+      }
+      h.sum = cell(m.first + detail::metrics::histogram_buckets);
+    }
+    return snap;
+  }
+};
+
+namespace detail::metrics {
+
+inline thread_local shard* this_thread_shard = nullptr;
+
+// Allocates the calling thread's shard; it is folded into the registry when the thread exits.
+[[nodiscard]] inline auto
+attach_this_thread() -> shard*
+{
+  struct holder
+  {
+    std::unique_ptr<shard> s{ new shard };
+
+    holder()
+    {
+      metrics_registry::instance().attach(s.get());
+    }
+
+    ~holder()
+    {
+      metrics_registry::instance().detach(s.get());
+      this_thread_shard = nullptr;
+    }
+  };
+  thread_local holder h;
+  this_thread_shard = h.s.get();
+  return this_thread_shard;
+}
+
+[[nodiscard]] inline auto
+local() -> shard&
+{
+  auto* s = this_thread_shard;
+  if (s == nullptr)
+    MTP_UNLIKELY
+    {
+      s = attach_this_thread();
+    }
+  return *s;
+}
+
+} // namespace detail::metrics
+
+// -------------------------------------------------------------------------------------------------
+// counter / histogram
+// -------------------------------------------------------------------------------------------------
+
+MTP_EXPORT template <basic_fixed_string Name>
+  requires(std::is_same_v<typename decltype(Name)::value_type, char>)
+class counter
+{
+public:
+  static constexpr auto name = Name;
+
+  // Number of cells this metric occupies in every shard.
+  static constexpr std::size_t cells = 1;
+
+  // First cell of this metric in every shard, assigned on first use.
+  [[nodiscard]] static auto
+  slot() -> std::size_t
+  {
+    static std::size_t const first =
+      metrics_registry::instance().add(Name.view(), detail::metrics::kind::counter);
+    return first;
+  }
+
+  // A thread's first update allocates its shard and may throw `std::bad_alloc`.
+  static auto
+  add(std::uint64_t n = 1) -> void
+  {
+    detail::metrics::bump(detail::metrics::local().cells[slot()], n);
+  }
+};
+
+MTP_EXPORT template <basic_fixed_string Name>
+  requires(std::is_same_v<typename decltype(Name)::value_type, char>)
+class histogram
+{
+public:
+  static constexpr auto name = Name;
+  static constexpr std::size_t cells = detail::metrics::histogram_cells;
+
+  [[nodiscard]] static auto
+  slot() -> std::size_t
+  {
+    static std::size_t const first =
+      metrics_registry::instance().add(Name.view(), detail::metrics::kind::histogram);
+    return first;
+  }
+
+  static auto
+  record(std::uint64_t value) -> void
+  {
+    auto* cells = detail::metrics::local().cells + slot();
+    detail::metrics::bump(cells[std::bit_width(value)], 1);
+    detail::metrics::bump(cells[detail::metrics::histogram_buckets], value);
+  }
+};
+
+} // namespace mtp
+
+// -------------------------------------------------------------------------------------------------
+
+#undef MTP_EXPORT
+#undef MTP_UNLIKELY
+
+// -------------------------------------------------------------------------------------------------
+
+#endif // MTP_METRICS_HPP
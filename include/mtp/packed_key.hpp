@@ -0,0 +1,226 @@
+#ifndef MTP_PACKED_KEY_HPP
+#define MTP_PACKED_KEY_HPP
+
+// -------------------------------------------------------------------------------------------------
+
+#include <mtp/fixed_string.hpp>
+
+// -------------------------------------------------------------------------------------------------
+
+#ifndef MTP_EXPORT
+#  define MTP_EXPORT
+#endif
+
+#if defined(__SIZEOF_INT128__)
+#  define MTP_PACKED_INT128
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+#ifndef MTP_BUILD_MODULE
+#  include <bit>
+#  if defined(__cpp_lib_three_way_comparison) && defined(__cpp_impl_three_way_comparison)
+#    include <compare>
+#  endif
+#  include <cstddef>
+#  include <cstdint>
+#  include <cstring>
+#  include <functional>
+#  include <type_traits>
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+namespace mtp {
+
+// -------------------------------------------------------------------------------------------------
+// packing
+// -------------------------------------------------------------------------------------------------
+//
+// The characters of a key are stored big-endian in one unsigned integer, first character in the
+// most significant byte and zero padded at the low end. Keys of one length N share the padding, so
+// the packing is lossless and integer order equals `basic_string_view` order (which compares
+// `char` as `unsigned char`).
+
+namespace detail::packed {
+
+#ifdef MTP_PACKED_INT128
+__extension__ typedef unsigned __int128 uint128;
+inline constexpr std::size_t max_size = 16;
+
+template <std::size_t N>
+using rep = std::conditional_t<(N <= 8), std::uint64_t, uint128>;
+#else
+inline constexpr std::size_t max_size = 8;
+
+template <std::size_t N>
+using rep = std::uint64_t;
+#endif
+
+[[nodiscard]] constexpr auto
+byteswap(std::uint64_t x) noexcept -> std::uint64_t
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_bswap64(x);
+#else
+  x = ((x & 0x00FF00FF00FF00FFu) << 8) | ((x >> 8) & 0x00FF00FF00FF00FFu);
+  x = ((x & 0x0000FFFF0000FFFFu) << 16) | ((x >> 16) & 0x0000FFFF0000FFFFu);
+  return (x << 32) | (x >> 32);
+#endif
+}
+
+// the `n` (<= 8) characters at `str` as a big-endian word
+[[nodiscard]] constexpr auto
+load(char const* str, std::size_t n) noexcept -> std::uint64_t
+{
+  std::uint64_t v = 0;
+  if (std::is_constant_evaluated()) {
+    for (std::size_t i = 0; i < n; ++i) {
+      v |= std::uint64_t{ static_cast<unsigned char>(str[i]) } << (56 - 8 * i);
+    }
+    return v;
+  }
+  std::memcpy(&v, str, n);
+  return std::endian::native == std::endian::little ? byteswap(v) : v;
+}
+
+constexpr auto
+store(std::uint64_t v, char* str, std::size_t n) noexcept -> void
+{
+  if (std::is_constant_evaluated()) {
+    for (std::size_t i = 0; i < n; ++i) {
+      str[i] = static_cast<char>(v >> (56 - 8 * i));
+    }
+    return;
+  }
+  v = std::endian::native == std::endian::little ? byteswap(v) : v;
+  std::memcpy(str, &v, n);
+}
+
+} // namespace detail::packed
+
+// -------------------------------------------------------------------------------------------------
+// packed_key
+// -------------------------------------------------------------------------------------------------
+
+// A `fixed_string<N>` packed into one integer: comparisons are a single integer compare and
+// hashing is one integer finalizer. N is limited to 16 characters (8 without `unsigned __int128`).
+MTP_EXPORT template <std::size_t N>
+  requires(N <= detail::packed::max_size)
+class packed_key
+{
+public:
+  using rep_type = detail::packed::rep<N>;
+
+  // public to be a structural type (usable as NTTP)
+  rep_type _bits{};
+
+  static constexpr std::integral_constant<std::size_t, N> size{};
+
+  // The key of N '\0' characters.
+  constexpr packed_key() noexcept = default;
+
+  explicit constexpr packed_key(basic_fixed_string<char, N> const& str) noexcept
+  {
+    if constexpr (N <= 8) {
+      _bits = detail::packed::load(str.data(), N);
+    } else {
+      _bits = (rep_type{ detail::packed::load(str.data(), 8) } << 64) |
+              detail::packed::load(str.data() + 8, N - 8);
+    }
+  }
+
+  // Reinterprets packed bits; the low padding bits must be zero.
+  [[nodiscard]] static constexpr auto
+  from_bits(rep_type bits) noexcept -> packed_key
+  {
+    packed_key key;
+    key._bits = bits;
+    return key;
+  }
+
+  [[nodiscard]] constexpr auto
+  bits() const noexcept -> rep_type
+  {
+    return _bits;
+  }
+
+  [[nodiscard]] constexpr auto
+  unpack() const noexcept -> basic_fixed_string<char, N>
+  {
+    char buf[N == 0 ? 1 : N]{};
+    if constexpr (N <= 8) {
+      detail::packed::store(static_cast<std::uint64_t>(_bits), buf, N);
+    } else {
+      detail::packed::store(static_cast<std::uint64_t>(_bits >> 64), buf, 8);
+      detail::packed::store(static_cast<std::uint64_t>(_bits), buf + 8, N - 8);
+    }
+    return basic_fixed_string<char, N>(buf, buf + N);
+  }
+
+  explicit constexpr
+  operator basic_fixed_string<char, N>() const noexcept
+  {
+    return unpack();
+  }
+
+  [[nodiscard]] friend constexpr auto
+  operator==(packed_key const&, packed_key const&) noexcept -> bool = default;
+
+#if defined(__cpp_lib_three_way_comparison) && defined(__cpp_impl_three_way_comparison)
+  [[nodiscard]] friend constexpr auto
+  operator<=>(packed_key const&, packed_key const&) noexcept -> std::strong_ordering = default;
+#else
+  [[nodiscard]] friend constexpr auto
+  operator<(packed_key const& lhs, packed_key const& rhs) noexcept -> bool
+  {
+    return lhs._bits < rhs._bits;
+  }
+#endif
+};
+
+MTP_EXPORT template <std::size_t N>
+packed_key(basic_fixed_string<char, N> const&) -> packed_key<N>;
+
+// The packed form of a constant key.
+MTP_EXPORT template <basic_fixed_string Str>
+  requires(std::is_same_v<typename decltype(Str)::value_type, char>)
+inline constexpr auto pack = packed_key<Str.size()>{ Str };
+
+} // namespace mtp
+
+// -------------------------------------------------------------------------------------------------
+// hashing support
+// -------------------------------------------------------------------------------------------------
+
+// The murmur3 64-bit finalizer over the key; keys longer than 8 characters first fold their high
+// word in with a multiply.
+MTP_EXPORT template <std::size_t N>
+struct std::hash<mtp::packed_key<N>>
+{
+  [[nodiscard]] constexpr auto
+  operator()(mtp::packed_key<N> const& key) const noexcept -> std::size_t
+  {
+    auto x = static_cast<std::uint64_t>(key._bits);
+#ifdef MTP_PACKED_INT128
+    if constexpr (N > 8) {
+      x ^= static_cast<std::uint64_t>(key._bits >> 64) * 0x9E3779B97F4A7C15u;
+    }
+#endif
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDu;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53u;
+    x ^= x >> 33;
+    return static_cast<std::size_t>(x);
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
+
+#undef MTP_EXPORT
+#undef MTP_PACKED_INT128
+
+// -------------------------------------------------------------------------------------------------
+
+#endif // MTP_PACKED_KEY_HPP
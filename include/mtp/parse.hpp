@@ -0,0 +1,203 @@
+#ifndef MTP_PARSE_HPP
+#define MTP_PARSE_HPP
+
+// -------------------------------------------------------------------------------------------------
+
+#include <mtp/fixed_string.hpp>
+
+// -------------------------------------------------------------------------------------------------
+
+#ifndef MTP_EXPORT
+#  define MTP_EXPORT
+#endif
+
+// Without exceptions the throwing overloads cannot report invalid input and abort instead of
+// returning an unspecified value; use the `std::errc&` overloads to handle it.
+#if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+#  define MTP_THROW(except) throw except
+#else
+#  define MTP_THROW(except) std::abort()
+#endif
+
+#if __has_cpp_attribute(unlikely)
+#  define MTP_UNLIKELY [[unlikely]]
+#else
+#  define MTP_UNLIKELY
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+#ifndef MTP_BUILD_MODULE
+#  include <concepts>
+#  include <cstddef>
+#  include <cstdint>
+#  include <limits>
+#  if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+#    include <stdexcept>
+#  else
+#    include <cstdlib>
+#  endif
+#  include <system_error>
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+namespace mtp {
+
+// -------------------------------------------------------------------------------------------------
+// swar digit parsing
+// -------------------------------------------------------------------------------------------------
+//
+// Fixed-width decimal fields are parsed eight digits at a time: the digits are loaded into a
+// 64-bit word (first digit in the low byte), validated with two masks and folded into a value with
+// three multiply-shift steps. A field shorter than a multiple of eight is left-padded with '0'.
+// There are no data-dependent branches; invalid input only clears the `ok` flag.
+
+namespace detail::swar {
+
+inline constexpr std::uint64_t zeros = 0x3030303030303030u;
+
+// bytes p[0, K) in the top K bytes of the word, '0' below (i.e. the field left-padded to 8 digits)
+template <std::size_t K>
+[[nodiscard]] constexpr auto
+load(char const* p) noexcept -> std::uint64_t
+{
+  static_assert(K > 0 && K <= 8);
+  std::uint64_t v = 0;
+  for (auto i = 0u; i < K; ++i) {
+    v |= std::uint64_t{ static_cast<unsigned char>(p[i]) } << (8 * i);
+  }
+  if constexpr (K == 8) {
+    return v;
+  } else {
+    return (v << (8 * (8 - K))) | (zeros >> (8 * K));
+  }
+}
+
+[[nodiscard]] constexpr auto
+valid(std::uint64_t v) noexcept -> bool
+{
+  auto const d = v - zeros;
+  return ((d | (d + 0x7676767676767676u)) & 0x8080808080808080u) == 0;
+}
+
+[[nodiscard]] constexpr auto
+fold(std::uint64_t v) noexcept -> std::uint64_t
+{
+  v -= zeros;
+  v = (v * 10) + (v >> 8);
+  v = ((v & 0x000000FF000000FFu) * (100 + (1000000ull << 32)) +
+       ((v >> 16) & 0x000000FF000000FFu) * (1 + (10000ull << 32))) >>
+      32;
+  return v;
+}
+
+[[nodiscard]] constexpr auto
+pow10(std::size_t n) noexcept -> std::uint64_t
+{
+  std::uint64_t p = 1;
+  for (; n > 0; --n) {
+    p *= 10;
+  }
+  return p;
+}
+
+// Parses the K digits at p. K is a compile-time constant, so the chunk loop fully unrolls.
+template <std::size_t K>
+[[nodiscard]] constexpr auto
+digits(char const* p, bool& ok) noexcept -> std::uint64_t
+{
+  static_assert(K <= 19, "more than 19 digits may overflow 64 bits");
+  if constexpr (K == 0) {
+    return 0;
+  } else {
+    constexpr auto head = K % 8 == 0 ? 8 : K % 8;
+    auto const w = load<head>(p);
+    ok &= valid(w);
+    auto value = fold(w);
+    for (auto i = head; i < K; i += 8) {
+      auto const c = load<8>(p + i);
+      ok &= valid(c);
+      value = value * 100000000u + fold(c);
+    }
+    return value;
+  }
+}
+
+} // namespace detail::swar
+
+// -------------------------------------------------------------------------------------------------
+// parse
+// -------------------------------------------------------------------------------------------------
+
+// Parses a zero-padded, fixed-width unsigned decimal field. `ec` is set to
+// `std::errc::invalid_argument` (and the result is unspecified) if any character is not a digit.
+MTP_EXPORT template <std::unsigned_integral T, std::size_t N>
+  requires(N <= std::numeric_limits<T>::digits10)
+[[nodiscard]] constexpr auto
+parse(fixed_string<N> const& fs, std::errc& ec) noexcept -> T
+{
+  bool ok = true;
+  auto const value = detail::swar::digits<N>(fs.data(), ok);
+  ec = ok ? std::errc{} : std::errc::invalid_argument;
+  return static_cast<T>(value);
+}
+
+// As above, but throws `std::invalid_argument` (aborts without exceptions) on invalid input.
+MTP_EXPORT template <std::unsigned_integral T, std::size_t N>
+  requires(N <= std::numeric_limits<T>::digits10)
+[[nodiscard]] constexpr auto
+parse(fixed_string<N> const& fs) -> T
+{
+  std::errc ec{};
+  auto const value = parse<T>(fs, ec);
+  if (ec != std::errc{})
+    MTP_UNLIKELY
+    {
+      MTP_THROW(std::invalid_argument("mtp::parse"));
+    }
+  return value;
+}
+
+// Parses a fixed-point field laid out as `I` integer digits, '.', `Frac` fraction digits (I may be
+// zero) and returns it in units of 10^-Frac, e.g. parse_decimal<4>("000187.2500") == 1872500.
+MTP_EXPORT template <std::size_t Frac, std::unsigned_integral T = std::uint64_t, std::size_t N>
+  requires(N > Frac && N - 1 <= std::numeric_limits<T>::digits10)
+[[nodiscard]] constexpr auto
+parse_decimal(fixed_string<N> const& fs, std::errc& ec) noexcept -> T
+{
+  constexpr auto int_digits = N - 1 - Frac;
+  bool ok = fs.data()[int_digits] == '.';
+  auto const int_part = detail::swar::digits<int_digits>(fs.data(), ok);
+  auto const frac_part = detail::swar::digits<Frac>(fs.data() + int_digits + 1, ok);
+  ec = ok ? std::errc{} : std::errc::invalid_argument;
+  return static_cast<T>(int_part * detail::swar::pow10(Frac) + frac_part);
+}
+
+// As above, but throws `std::invalid_argument` (aborts without exceptions) on invalid input.
+MTP_EXPORT template <std::size_t Frac, std::unsigned_integral T = std::uint64_t, std::size_t N>
+  requires(N > Frac && N - 1 <= std::numeric_limits<T>::digits10)
+[[nodiscard]] constexpr auto
+parse_decimal(fixed_string<N> const& fs) -> T
+{
+  std::errc ec{};
+  auto const value = parse_decimal<Frac, T>(fs, ec);
+  if (ec != std::errc{})
+    MTP_UNLIKELY
+    {
+      MTP_THROW(std::invalid_argument("mtp::parse_decimal"));
+    }
+  return value;
+}
+
+} // namespace mtp
+
+// -------------------------------------------------------------------------------------------------
+
+#undef MTP_EXPORT
+#undef MTP_THROW
+#undef MTP_UNLIKELY
+
+// -------------------------------------------------------------------------------------------------
+
+#endif // MTP_PARSE_HPP
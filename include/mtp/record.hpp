@@ -0,0 +1,223 @@
+#ifndef MTP_RECORD_HPP
+#define MTP_RECORD_HPP
+
+// -------------------------------------------------------------------------------------------------
+
+#include <mtp/fixed_string.hpp>
+#include <mtp/parse.hpp>
+
+// -------------------------------------------------------------------------------------------------
+
+#ifndef MTP_EXPORT
+#  define MTP_EXPORT
+#endif
+
+#ifndef MTP_EXPECTS
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    define MTP_EXPECTS(cond) __assume(cond)
+#  elif defined(__GNUC__) || defined(__clang__)
+#    define MTP_EXPECTS(cond) ((cond) ? static_cast<void>(0) : __builtin_unreachable())
+#  else
+#    define MTP_EXPECTS(cond)
+#  endif
+#endif
+
+#if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+#  define MTP_THROW(except) throw except
+#else
+#  define MTP_THROW(except)
+#endif
+
+#if __has_cpp_attribute(unlikely)
+#  define MTP_UNLIKELY [[unlikely]]
+#else
+#  define MTP_UNLIKELY
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+#ifndef MTP_BUILD_MODULE
+#  include <array>
+#  include <concepts>
+#  include <cstddef>
+#  include <limits>
+#  include <span>
+#  if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+#    include <stdexcept>
+#  endif
+#  include <string_view>
+#  include <system_error>
+#  include <tuple>
+#  include <type_traits>
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+namespace mtp {
+
+// -------------------------------------------------------------------------------------------------
+// field
+// -------------------------------------------------------------------------------------------------
+
+// A fixed-width field of a record. `T` is either `std::string_view` (the raw characters) or an
+// unsigned integer type, in which case the field holds a zero-padded decimal parsed with SWAR.
+MTP_EXPORT template <basic_fixed_string Name, std::size_t Width, typename T = std::string_view>
+  requires(std::is_same_v<typename decltype(Name)::value_type, char> &&
+           (std::is_same_v<T, std::string_view> ||
+            (std::unsigned_integral<T> && Width <= std::numeric_limits<T>::digits10)))
+struct field
+{
+  using value_type = T;
+
+  static constexpr auto name = Name;
+  static constexpr std::size_t width = Width;
+
+  [[nodiscard]] static constexpr auto
+  decode(char const* p, bool& ok) noexcept -> T
+  {
+    if constexpr (std::is_same_v<T, std::string_view>) {
+      return std::string_view{ p, Width };
+    } else {
+      return static_cast<T>(detail::swar::digits<Width>(p, ok));
+    }
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
+// record
+// -------------------------------------------------------------------------------------------------
+
+// Zero-copy view of one fixed-width record. Field offsets are computed at compile time, so
+// `get<"qty">()` is a load at a constant offset (plus the SWAR parse for numeric fields).
+MTP_EXPORT template <typename... Fields>
+class record
+{
+  static_assert((0 + ... + Fields::width) > 0, "mtp::record: needs at least one non-empty field");
+
+  static constexpr std::array<std::size_t, sizeof...(Fields) + 1> _offsets = [] {
+    std::array<std::size_t, sizeof...(Fields) + 1> offsets{};
+    std::size_t i = 0;
+    ((offsets[i + 1] = offsets[i] + Fields::width, ++i), ...);
+    return offsets;
+  }();
+
+  template <basic_fixed_string Name>
+  static constexpr std::size_t _index = [] {
+    constexpr bool matches[] = { (Fields::name == Name)..., false };
+    std::size_t index = sizeof...(Fields);
+    std::size_t count = 0;
+    for (auto i = 0u; i < sizeof...(Fields); ++i) {
+      if (matches[i]) {
+        index = i;
+        ++count;
+      }
+    }
+    return count == 1 ? index : sizeof...(Fields);
+  }();
+
+  template <basic_fixed_string Name>
+  using _field = std::tuple_element_t<_index<Name>, std::tuple<Fields...>>;
+
+  char const* _data = nullptr;
+
+public:
+  static constexpr std::integral_constant<std::size_t, _offsets.back()> size{};
+
+  template <basic_fixed_string Name>
+    requires(_index<Name> < sizeof...(Fields))
+  static constexpr std::size_t offset_of = _offsets[_index<Name>];
+
+  template <basic_fixed_string Name>
+    requires(_index<Name> < sizeof...(Fields))
+  using type_of = typename _field<Name>::value_type;
+
+  record() = default;
+
+  // `data` must point at `size()` readable characters for as long as the record is used
+  constexpr explicit record(char const* data) noexcept : _data{ data } {}
+
+  [[nodiscard]] constexpr auto
+  data() const noexcept -> char const*
+  {
+    return _data;
+  }
+
+  template <basic_fixed_string Name>
+    requires(_index<Name> < sizeof...(Fields))
+  [[nodiscard]] constexpr auto
+  raw() const noexcept -> std::string_view
+  {
+    return { _data + offset_of<Name>, _field<Name>::width };
+  }
+
+  template <basic_fixed_string Name>
+    requires(_index<Name> < sizeof...(Fields))
+  [[nodiscard]] constexpr auto
+  get(std::errc& ec) const noexcept -> type_of<Name>
+  {
+    bool ok = true;
+    auto const value = _field<Name>::decode(_data + offset_of<Name>, ok);
+    ec = ok ? std::errc{} : std::errc::invalid_argument;
+    return value;
+  }
+
+  template <basic_fixed_string Name>
+    requires(_index<Name> < sizeof...(Fields))
+  [[nodiscard]] constexpr auto
+  get() const -> type_of<Name>
+  {
+    std::errc ec{};
+    auto const value = get<Name>(ec);
+    if (ec != std::errc{})
+      MTP_UNLIKELY
+      {
+        MTP_THROW(std::invalid_argument("mtp::record::get"));
+      }
+    return value;
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // batch decoding
+  // -----------------------------------------------------------------------------------------------
+
+  // Number of whole records in `bytes` when records are `stride` characters apart (`stride` may
+  // exceed `size()`, e.g. for newline terminated records).
+  [[nodiscard]] static constexpr auto
+  count(std::span<char const> bytes, std::size_t stride = size()) noexcept -> std::size_t
+  {
+    MTP_EXPECTS(stride >= size());
+    return bytes.size() < size() ? 0 : (bytes.size() - size()) / stride + 1;
+  }
+
+  // Decodes field `Name` of every record in `bytes` into the column `out` (which must hold
+  // `count(bytes, stride)` values). `ec` reports whether any value failed to parse.
+  template <basic_fixed_string Name>
+    requires(_index<Name> < sizeof...(Fields))
+  static constexpr auto
+  decode_column(std::span<char const> bytes, std::span<type_of<Name>> out, std::errc& ec,
+                std::size_t stride = size()) noexcept -> std::size_t
+  {
+    auto const n = count(bytes, stride);
+    MTP_EXPECTS(out.size() >= n);
+    bool ok = true;
+    for (std::size_t i = 0; i < n; ++i) {
+      // only pointers into a whole record are formed, and none for an empty `bytes`
+      out[i] = _field<Name>::decode(bytes.data() + i * stride + offset_of<Name>, ok);
+    }
+    ec = ok ? std::errc{} : std::errc::invalid_argument;
+    return n;
+  }
+};
+
+} // namespace mtp
+
+// -------------------------------------------------------------------------------------------------
+
+#undef MTP_EXPORT
+#undef MTP_EXPECTS
+#undef MTP_THROW
+#undef MTP_UNLIKELY
+
+// -------------------------------------------------------------------------------------------------
+
+#endif // MTP_RECORD_HPP
@@ -0,0 +1,248 @@
+#ifndef MTP_ROUTER_HPP
+#define MTP_ROUTER_HPP
+
+// -------------------------------------------------------------------------------------------------
+
+#include <mtp/fixed_string.hpp>
+
+// -------------------------------------------------------------------------------------------------
+
+#ifndef MTP_EXPORT
+#  define MTP_EXPORT
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+#ifndef MTP_BUILD_MODULE
+#  include <bit>
+#  include <cstddef>
+#  include <cstdint>
+#  include <cstring>
+#  include <string_view>
+#  include <type_traits>
+#  include <utility>
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+namespace mtp {
+
+// -------------------------------------------------------------------------------------------------
+// route match
+// -------------------------------------------------------------------------------------------------
+
+MTP_EXPORT struct route_match
+{
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  // index of the matched route in the router's parameter list, or `npos`
+  std::size_t index = npos;
+  // the input past the matched prefix (the whole input when nothing matched)
+  std::string_view suffix{};
+
+  [[nodiscard]] constexpr explicit
+  operator bool() const noexcept
+  {
+    return index != npos;
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
+// compile-time radix trie
+// -------------------------------------------------------------------------------------------------
+
+namespace detail::router {
+
+inline constexpr std::size_t npos = route_match::npos;
+
+// A radix trie over R routes has at most 2R + 1 nodes (each insertion adds a leaf and may split one
+// edge) and a node has at most R children. Edge labels are views into the route strings.
+template <std::size_t R>
+struct trie
+{
+  struct node
+  {
+    std::size_t route = npos;
+    std::string_view label{};
+    std::size_t child_count = 0;
+    std::size_t children[R]{};
+  };
+
+  node nodes[2 * R + 1]{};
+  std::size_t count = 1;
+  bool distinct = true;
+
+  constexpr auto
+  insert(std::string_view route, std::size_t index) noexcept -> void
+  {
+    std::size_t n = 0;
+    std::size_t pos = 0;
+    while (pos != route.size()) {
+      auto const rest = route.substr(pos);
+      auto* child = static_cast<std::size_t*>(nullptr);
+      for (auto i = 0u; i < nodes[n].child_count; ++i) {
+        if (nodes[nodes[n].children[i]].label[0] == rest[0]) {
+          child = &nodes[n].children[i];
+        }
+      }
+      if (child == nullptr) {
+        nodes[count] = node{ index, rest };
+        nodes[n].children[nodes[n].child_count++] = count++;
+        return;
+      }
+
+      auto const label = nodes[*child].label;
+      std::size_t common = 0;
+      while (common < label.size() && common < rest.size() && label[common] == rest[common]) {
+        ++common;
+      }
+      if (common < label.size()) {
+        // split the edge: the shared part becomes a new interior node above the old child
+        auto const mid = count++;
+        nodes[mid] = node{ npos, label.substr(0, common) };
+        nodes[mid].children[nodes[mid].child_count++] = *child;
+        nodes[*child].label = label.substr(common);
+        *child = mid;
+      }
+      n = *child;
+      pos += common;
+    }
+    distinct &= nodes[n].route == npos;
+    nodes[n].route = index;
+  }
+};
+
+template <std::size_t R>
+[[nodiscard]] constexpr auto
+make_trie(std::string_view const (&routes)[R]) noexcept -> trie<R>
+{
+  trie<R> t{};
+  for (auto i = 0u; i < R; ++i) {
+    t.insert(routes[i], i);
+  }
+  return t;
+}
+
+// Little-endian word of the K <= 8 bytes at p. On little-endian targets this is a plain load.
+template <std::size_t K>
+[[nodiscard]] constexpr auto
+load(char const* p) noexcept -> std::uint64_t
+{
+  std::uint64_t v = 0;
+  if constexpr (std::endian::native == std::endian::little) {
+    if (!std::is_constant_evaluated()) {
+      std::memcpy(&v, p, K);
+      return v;
+    }
+  }
+  for (auto i = 0u; i < K; ++i) {
+    v |= std::uint64_t{ static_cast<unsigned char>(p[i]) } << (8 * i);
+  }
+  return v;
+}
+
+// Compares the input at p against a compile-time label a word at a time; the label words are
+// immediates. A tail shorter than a word reuses an overlapping load when the label is long enough.
+template <std::string_view const& Label>
+[[nodiscard]] constexpr auto
+equal(char const* p) noexcept -> bool
+{
+  constexpr auto L = Label.size();
+  constexpr auto full = L / 8;
+  bool eq = true;
+  [&]<std::size_t... Ks>(std::index_sequence<Ks...>) {
+    ((eq = eq && load<8>(p + 8 * Ks) == load<8>(Label.data() + 8 * Ks)), ...);
+  }(std::make_index_sequence<full>{});
+  if constexpr (L % 8 != 0) {
+    if constexpr (L >= 8) {
+      eq = eq && load<8>(p + L - 8) == load<8>(Label.data() + L - 8);
+    } else {
+      eq = eq && load<L>(p) == load<L>(Label.data());
+    }
+  }
+  return eq;
+}
+
+} // namespace detail::router
+
+// -------------------------------------------------------------------------------------------------
+// prefix_router
+// -------------------------------------------------------------------------------------------------
+
+// Longest-prefix match over a route table fixed at compile time. The routes are assembled into a
+// radix trie whose walk is unrolled into nested dispatch: each node tests the next input byte
+// against its children's first bytes, then compares the child's edge label a word at a time. Each
+// input byte is examined once, so matching is linear in the length of the matched prefix.
+MTP_EXPORT template <basic_fixed_string... Routes>
+  requires(sizeof...(Routes) > 0 &&
+           (std::is_same_v<typename decltype(Routes)::value_type, char> && ...))
+class prefix_router
+{
+  static constexpr std::string_view _routes[] = { Routes.view()... };
+  static constexpr auto _trie = detail::router::make_trie(_routes);
+  static_assert(_trie.distinct, "mtp::prefix_router: duplicate route");
+
+  template <std::size_t I>
+  static constexpr std::string_view _label = _trie.nodes[I].label;
+
+  template <std::size_t I>
+  static constexpr auto
+  walk(char const* p, std::size_t n, std::size_t pos, route_match& best) noexcept -> void
+  {
+    constexpr auto& node = _trie.nodes[I];
+    if constexpr (node.route != detail::router::npos) {
+      best.index = node.route;
+      best.suffix = std::string_view{ p + pos, n - pos };
+    }
+    if constexpr (node.child_count != 0) {
+      if (pos == n) {
+        return;
+      }
+      // children have distinct first bytes, so at most one branch is taken
+      auto const c = p[pos];
+      [&]<std::size_t... Cs>(std::index_sequence<Cs...>) {
+        static_cast<void>(((c == _label<node.children[Cs]>[0] &&
+                            (step<node.children[Cs]>(p, n, pos, best), true)) ||
+                           ...));
+      }(std::make_index_sequence<node.child_count>{});
+    }
+  }
+
+  template <std::size_t J>
+  static constexpr auto
+  step(char const* p, std::size_t n, std::size_t pos, route_match& best) noexcept -> void
+  {
+    constexpr auto L = _label<J>.size();
+    if (n - pos >= L && detail::router::equal<_label<J>>(p + pos)) {
+      walk<J>(p, n, pos + L, best);
+    }
+  }
+
+public:
+  static constexpr std::integral_constant<std::size_t, sizeof...(Routes)> size{};
+
+  [[nodiscard]] static constexpr auto
+  route(std::size_t index) noexcept -> std::string_view
+  {
+    return _routes[index];
+  }
+
+  // Returns the longest route that is a prefix of `path`, and the rest of `path`.
+  [[nodiscard]] static constexpr auto
+  match(std::string_view path) noexcept -> route_match
+  {
+    auto best = route_match{ route_match::npos, path };
+    walk<0>(path.data(), path.size(), 0, best);
+    return best;
+  }
+};
+
+} // namespace mtp
+
+// -------------------------------------------------------------------------------------------------
+
+#undef MTP_EXPORT
+
+// -------------------------------------------------------------------------------------------------
+
+#endif // MTP_ROUTER_HPP
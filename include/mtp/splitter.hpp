@@ -0,0 +1,349 @@
+#ifndef MTP_SPLITTER_HPP
+#define MTP_SPLITTER_HPP
+
+// -------------------------------------------------------------------------------------------------
+
+#include <mtp/fixed_string.hpp>
+
+// -------------------------------------------------------------------------------------------------
+
+#ifndef MTP_EXPORT
+#  define MTP_EXPORT
+#endif
+
+#if defined(__SSSE3__)
+#  define MTP_SPLITTER_SSSE3
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define MTP_SPLITTER_SSE2
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+#ifndef MTP_BUILD_MODULE
+#  include <bit>
+#  include <cstddef>
+#  include <cstdint>
+#  include <iterator>
+#  include <ranges>
+#  include <string>
+#  include <string_view>
+#  include <type_traits>
+#endif
+#if defined(MTP_SPLITTER_SSSE3)
+#  include <tmmintrin.h>
+#elif defined(MTP_SPLITTER_SSE2)
+#  include <emmintrin.h>
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+namespace mtp {
+
+// -------------------------------------------------------------------------------------------------
+// byte classification
+// -------------------------------------------------------------------------------------------------
+
+namespace detail {
+
+// Set membership for a compile-time set of bytes: a 256 entry table for the scalar path, and the
+// low/high nibble tables for a pshufb lookup, which is exact as long as the set's bytes use at
+// most 8 distinct high nibbles (one bit per high nibble).
+struct byte_class
+{
+  bool table[256]{};
+  std::uint8_t lo[16]{};
+  std::uint8_t hi[16]{};
+  bool nibble_exact = true;
+  std::size_t count = 0;
+  unsigned char bytes[256]{};
+
+  [[nodiscard]] constexpr auto
+  contains(char c) const noexcept -> bool
+  {
+    return table[static_cast<unsigned char>(c)];
+  }
+};
+
+template <std::size_t N>
+[[nodiscard]] constexpr auto
+make_byte_class(basic_fixed_string<char, N> const& set, char extra) noexcept -> byte_class
+{
+  byte_class bc{};
+  auto add = [&](unsigned char c) {
+    if (bc.table[c]) {
+      return;
+    }
+    bc.table[c] = true;
+    bc.bytes[bc.count++] = c;
+  };
+  for (auto c : set) {
+    add(static_cast<unsigned char>(c));
+  }
+  if (extra != '\0') {
+    add(static_cast<unsigned char>(extra));
+  }
+
+  int bit_of_hi[16];
+  for (auto& b : bit_of_hi) {
+    b = -1;
+  }
+  int next_bit = 0;
+  for (auto i = 0u; i < bc.count; ++i) {
+    auto const h = bc.bytes[i] >> 4;
+    if (bit_of_hi[h] < 0) {
+      if (next_bit == 8) {
+        bc.nibble_exact = false;
+        break;
+      }
+      bit_of_hi[h] = next_bit++;
+      bc.hi[h] = static_cast<std::uint8_t>(1u << bit_of_hi[h]);
+    }
+    bc.lo[bc.bytes[i] & 0x0F] |= static_cast<std::uint8_t>(1u << bit_of_hi[h]);
+  }
+  return bc;
+}
+
+// Bit i of the result is set when p[i] is in the class, for the 16 bytes at p.
+template <byte_class const& BC>
+[[nodiscard]] inline auto
+match16(char const* p) noexcept -> std::uint32_t
+{
+#if defined(MTP_SPLITTER_SSSE3)
+  if constexpr (BC.nibble_exact) {
+    auto const lo = _mm_loadu_si128(reinterpret_cast<__m128i const*>(BC.lo));
+    auto const hi = _mm_loadu_si128(reinterpret_cast<__m128i const*>(BC.hi));
+    auto const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+    auto const lo_nib = _mm_and_si128(v, _mm_set1_epi8(0x0F));
+    auto const hi_nib = _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0F));
+    auto const hit = _mm_and_si128(_mm_shuffle_epi8(lo, lo_nib), _mm_shuffle_epi8(hi, hi_nib));
+    auto const miss = _mm_cmpeq_epi8(hit, _mm_setzero_si128());
+    return static_cast<std::uint32_t>(~_mm_movemask_epi8(miss)) & 0xFFFFu;
+  }
+#endif
+#if defined(MTP_SPLITTER_SSE2)
+  auto const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+  auto acc = _mm_setzero_si128();
+  for (auto i = 0u; i < BC.count; ++i) {
+    acc = _mm_or_si128(acc, _mm_cmpeq_epi8(v, _mm_set1_epi8(static_cast<char>(BC.bytes[i]))));
+  }
+  return static_cast<std::uint32_t>(_mm_movemask_epi8(acc));
+#else
+  std::uint32_t m = 0;
+  for (auto i = 0u; i < 16; ++i) {
+    m |= static_cast<std::uint32_t>(BC.contains(p[i])) << i;
+  }
+  return m;
+#endif
+}
+
+} // namespace detail
+
+// -------------------------------------------------------------------------------------------------
+// splitter
+// -------------------------------------------------------------------------------------------------
+
+// Tokenizer over a compile-time delimiter set. Tokens are the (possibly empty) spans between
+// delimiters, as with `std::views::split`. When `Quote` is not '\0', delimiters between a pair of
+// quote characters do not split; a doubled quote inside quotes stays part of the token. Tokens are
+// returned verbatim, quotes included.
+MTP_EXPORT template <basic_fixed_string Delims, char Quote = '\0'>
+  requires(std::is_same_v<typename decltype(Delims)::value_type, char> && Delims.size() > 0)
+class splitter
+{
+  static constexpr detail::byte_class _class = detail::make_byte_class(Delims, Quote);
+
+public:
+  [[nodiscard]] static constexpr auto
+  is_delimiter(char c) noexcept -> bool
+  {
+    return c != Quote && _class.contains(c);
+  }
+
+  // Returns the end of the token starting at `first` (a delimiter or `last`). `in_quotes` carries
+  // the quoting state across calls so a token may be scanned in several pieces.
+  [[nodiscard]] static auto
+  scan(char const* first, char const* last, bool& in_quotes) noexcept -> char const*
+  {
+    auto p = first;
+    for (; last - p >= 16; p += 16) {
+      for (auto m = detail::match16<_class>(p); m != 0; m &= m - 1) {
+        auto const q = p + std::countr_zero(m);
+        if (Quote != '\0' && *q == Quote) {
+          in_quotes = !in_quotes;
+        } else if (!in_quotes) {
+          return q;
+        }
+      }
+    }
+    for (; p != last; ++p) {
+      if (Quote != '\0' && *p == Quote) {
+        in_quotes = !in_quotes;
+      } else if (!in_quotes && _class.contains(*p)) {
+        return p;
+      }
+    }
+    return last;
+  }
+
+  [[nodiscard]] static auto
+  scan(char const* first, char const* last) noexcept -> char const*
+  {
+    bool in_quotes = false;
+    return scan(first, last, in_quotes);
+  }
+
+  // ---------------------------------------------------------------------------------------------
+  // lazy range of tokens
+  // ---------------------------------------------------------------------------------------------
+
+  class view : public std::ranges::view_interface<view>
+  {
+    std::string_view _str;
+
+  public:
+    class iterator
+    {
+      char const* _token = nullptr;
+      char const* _token_end = nullptr;
+      char const* _last = nullptr;
+
+    public:
+      using iterator_concept = std::forward_iterator_tag;
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = std::string_view;
+      using difference_type = std::ptrdiff_t;
+
+      iterator() = default;
+
+      iterator(char const* first, char const* last) noexcept
+        : _token{ first }, _token_end{ first == last ? nullptr : scan(first, last) }, _last{ last }
+      {}
+
+      [[nodiscard]] auto
+      operator*() const noexcept -> std::string_view
+      {
+        return { _token, static_cast<std::size_t>(_token_end - _token) };
+      }
+
+      auto
+      operator++() noexcept -> iterator&
+      {
+        if (_token_end == _last) {
+          _token_end = nullptr;
+        } else {
+          _token = _token_end + 1;
+          _token_end = scan(_token, _last);
+        }
+        return *this;
+      }
+
+      auto
+      operator++(int) noexcept -> iterator
+      {
+        auto tmp = *this;
+        ++*this;
+        return tmp;
+      }
+
+      [[nodiscard]] friend auto
+      operator==(iterator const& a, iterator const& b) noexcept -> bool
+      {
+        return a._token_end == b._token_end && (a._token_end == nullptr || a._token == b._token);
+      }
+
+      [[nodiscard]] friend auto
+      operator==(iterator const& it, std::default_sentinel_t) noexcept -> bool
+      {
+        return it._token_end == nullptr;
+      }
+    };
+
+    view() = default;
+
+    explicit view(std::string_view str) noexcept : _str{ str } {}
+
+    [[nodiscard]] auto
+    begin() const noexcept -> iterator
+    {
+      return iterator{ _str.data(), _str.data() + _str.size() };
+    }
+
+    [[nodiscard]] auto
+    end() const noexcept -> std::default_sentinel_t
+    {
+      return std::default_sentinel;
+    }
+  };
+
+  [[nodiscard]] static auto
+  split(std::string_view str) noexcept -> view
+  {
+    return view{ str };
+  }
+
+  // ---------------------------------------------------------------------------------------------
+  // streaming input
+  // ---------------------------------------------------------------------------------------------
+
+  // Splits input that arrives in chunks. Tokens wholly inside a chunk are passed on as views into
+  // it; only a token straddling a chunk boundary is copied into the carry buffer.
+  class stream
+  {
+    std::string _carry;
+    bool _in_quotes = false;
+    bool _pending = false;
+
+  public:
+    template <typename F>
+      requires(std::is_invocable_v<F&, std::string_view>)
+    auto
+    feed(std::string_view chunk, F&& f) -> void
+    {
+      auto p = chunk.data();
+      auto const last = p + chunk.size();
+      while (p != last) {
+        auto const end = scan(p, last, _in_quotes);
+        if (end == last) {
+          _carry.append(p, last);
+          _pending = true;
+          return;
+        }
+        if (_carry.empty()) {
+          f(std::string_view{ p, static_cast<std::size_t>(end - p) });
+        } else {
+          _carry.append(p, end);
+          f(std::string_view{ _carry });
+          _carry.clear();
+        }
+        p = end + 1;
+        _pending = true; // a delimiter always opens another (possibly empty) token
+      }
+    }
+
+    template <typename F>
+      requires(std::is_invocable_v<F&, std::string_view>)
+    auto
+    finish(F&& f) -> void
+    {
+      if (_pending) {
+        f(std::string_view{ _carry });
+      }
+      _carry.clear();
+      _in_quotes = false;
+      _pending = false;
+    }
+  };
+};
+
+} // namespace mtp
+
+// -------------------------------------------------------------------------------------------------
+
+#undef MTP_EXPORT
+#undef MTP_SPLITTER_SSSE3
+#undef MTP_SPLITTER_SSE2
+
+// -------------------------------------------------------------------------------------------------
+
+#endif // MTP_SPLITTER_HPP
@@ -12,24 +12,53 @@ module;
 #  include <version>
 
 #  include <algorithm>
+#  include <array>
+#  include <atomic>
+#  include <bit>
+#  include <charconv>
+#  include <chrono>
+#  include <cmath>
 #  if defined(__cpp_lib_three_way_comparison) && defined(__cpp_impl_three_way_comparison)
 #    include <compare>
 #  endif
 #  include <concepts>
 #  include <cstddef>
+#  include <cstdint>
+#  include <cstdio>
+#  include <cstring>
 #  ifdef __cpp_lib_format
 #    include <format>
 #  endif
 #  include <functional>
+#  include <iosfwd>
 #  include <iterator>
-#  if defined(__cpp_lib_containers_ranges) || defined(__cpp_lib_ranges_to_container)
-#    include <ranges>
-#  endif
+#  include <limits>
+#  include <memory>
+#  include <mutex>
+#  include <new>
+#  include <ranges>
+#  include <span>
 #  if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
 #    include <stdexcept>
+#  else
+#    include <cstdlib>
 #  endif
+#  include <string>
 #  include <string_view>
+#  include <system_error>
+#  include <thread>
+#  include <tuple>
 #  include <type_traits>
+#  include <unordered_map>
+#  include <unordered_set>
+#  include <utility>
+#  include <vector>
+#endif
+
+#if defined(__SSSE3__)
+#  include <tmmintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
 #endif
 
 // -------------------------------------------------------------------------------------------------
@@ -47,3 +76,36 @@ import std;
 #define MTP_BUILD_MODULE
 #define MTP_EXPORT export
 #include <mtp/fixed_string.hpp>
+
+#define MTP_EXPORT export
+#include <mtp/compressed.hpp>
+
+#define MTP_EXPORT export
+#include <mtp/interner.hpp>
+
+#define MTP_EXPORT export
+#include <mtp/splitter.hpp>
+
+#define MTP_EXPORT export
+#include <mtp/parse.hpp>
+
+#define MTP_EXPORT export
+#include <mtp/record.hpp>
+
+#define MTP_EXPORT export
+#include <mtp/hash.hpp>
+
+#define MTP_EXPORT export
+#include <mtp/router.hpp>
+
+#define MTP_EXPORT export
+#include <mtp/json.hpp>
+
+#define MTP_EXPORT export
+#include <mtp/log.hpp>
+
+#define MTP_EXPORT export
+#include <mtp/metrics.hpp>
+
+#define MTP_EXPORT export
+#include <mtp/packed_key.hpp>
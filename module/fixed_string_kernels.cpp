@@ -0,0 +1,49 @@
+module;
+
+// -------------------------------------------------------------------------------------------------
+
+#if !defined(MTP_USE_STD_MODULE) && defined(__cpp_lib_modules)
+#  define MTP_USE_STD_MODULE
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+#ifndef MTP_USE_STD_MODULE
+#  include <version>
+
+#  include <algorithm>
+#  include <cstddef>
+#  include <ostream>
+#  include <string_view>
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+module mtp.fixed_string;
+
+#ifdef MTP_USE_STD_MODULE
+import std;
+#endif
+
+// -------------------------------------------------------------------------------------------------
+// explicit instantiation definitions of the runtime kernels declared in fixed_string.hpp
+// -------------------------------------------------------------------------------------------------
+
+#define MTP_INSTANTIATE_KERNELS(CharT)                                                            \
+  template auto mtp::detail::equal_kernel<CharT>(CharT const*, CharT const*, std::size_t) noexcept \
+      -> bool;                                                                                    \
+  template auto mtp::detail::compare_kernel<CharT>(CharT const*, std::size_t, CharT const*,       \
+                                                   std::size_t) noexcept -> int;                  \
+  template auto mtp::detail::swap_kernel<CharT>(CharT*, CharT*, std::size_t) noexcept -> void;    \
+  template auto mtp::detail::write_kernel<CharT>(std::basic_ostream<CharT>&, CharT const*,        \
+                                                 std::size_t) -> std::basic_ostream<CharT>&
+
+MTP_INSTANTIATE_KERNELS(char);
+MTP_INSTANTIATE_KERNELS(wchar_t);
+#ifdef __cpp_char8_t
+MTP_INSTANTIATE_KERNELS(char8_t);
+#endif
+MTP_INSTANTIATE_KERNELS(char16_t);
+MTP_INSTANTIATE_KERNELS(char32_t);
+
+#undef MTP_INSTANTIATE_KERNELS
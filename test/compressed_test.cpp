@@ -0,0 +1,117 @@
+#include <catch2/catch.hpp>
+
+#include <version>
+
+#ifdef MTP_USE_STD_MODULE
+import std;
+#else
+#  include <algorithm>
+#  include <cstddef>
+#  include <string>
+#  include <string_view>
+#  include <thread>
+#  include <vector>
+#endif
+
+#ifdef MTP_BUILD_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/compressed.hpp>
+#endif
+
+#if __cpp_nontype_template_args >= 201911L // class type NTTPs
+
+namespace {
+
+using mtp::basic_fixed_string;
+using mtp::compressed;
+using mtp::fixed_string;
+
+template <basic_fixed_string Str>
+auto
+streamed() -> std::basic_string<typename decltype(Str)::value_type>
+{
+  std::basic_string<typename decltype(Str)::value_type> out;
+  for (auto c : compressed<Str>::stream()) {
+    out.push_back(c);
+  }
+  return out;
+}
+
+} // namespace
+
+TEST_CASE("compressed round trip", "[compressed]")
+{
+  SECTION("empty")
+  {
+    using c = compressed<fixed_string<0>{}>;
+    static_assert(c::size() == 0);
+    CHECK(c::view().empty());
+    CHECK(*c::c_str() == '\0');
+    CHECK(streamed<fixed_string<0>{}>().empty());
+  }
+
+  SECTION("incompressible")
+  {
+    using c = compressed<"abcdefg">;
+    static_assert(c::str() == "abcdefg");
+    CHECK(c::view() == "abcdefg");
+    CHECK(streamed<"abcdefg">() == "abcdefg");
+  }
+
+  SECTION("repetitive")
+  {
+    constexpr auto fs = basic_fixed_string{ "abcabcabcabcabcabcabcabcabcabcabcabc--abcabcabcabc" };
+    using c = compressed<fs>;
+    static_assert(c::compressed_size() < c::size());
+    static_assert(c::str() == fs);
+    CHECK(c::view() == fs.view());
+    CHECK(c::c_str()[c::size()] == '\0');
+    CHECK(streamed<fs>() == fs.view());
+  }
+
+  SECTION("long runs")
+  {
+    // literal and match lengths beyond the 4 bit token fields
+    constexpr auto fs = fixed_string<0>{} + "0123456789abcdefghijklmnopqrstuv" +
+                        "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx" +
+                        "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx" +
+                        "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx" +
+                        "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx" +
+                        "0123456789abcdefghijklmnopqrstuv!";
+    using c = compressed<fs>;
+    static_assert(c::compressed_size() < c::size() / 4);
+    static_assert(c::str() == fs);
+    CHECK(c::view() == fs.view());
+    CHECK(streamed<fs>() == fs.view());
+  }
+
+  SECTION("wide characters")
+  {
+    constexpr auto fs = basic_fixed_string{ U"été été été "
+                                            U"été \U0001F600\U0001F600" };
+    using c = compressed<fs>;
+    static_assert(c::str() == fs);
+    CHECK(c::view() == fs.view());
+    CHECK(streamed<fs>() == fs.view());
+  }
+}
+
+TEST_CASE("compressed concurrent first access", "[compressed]")
+{
+  constexpr auto fs = basic_fixed_string{ "concurrent concurrent concurrent concurrent access" };
+  using c = compressed<fs>;
+
+  std::vector<std::thread> threads;
+  std::vector<char const*> ptrs(8);
+  for (auto i = 0u; i < ptrs.size(); ++i) {
+    threads.emplace_back([&ptrs, i] { ptrs[i] = c::c_str(); });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  CHECK(std::all_of(ptrs.begin(), ptrs.end(), [&](auto p) { return p == ptrs[0]; }));
+  CHECK(c::view() == fs.view());
+}
+
+#endif
@@ -311,6 +311,77 @@ TEMPLATE_TEST_CASE("swap", "[fixed_string]", ALL_CHAR_TYPES)
   }
 }
 
+TEMPLATE_TEST_CASE("in-place modifiers", "[fixed_string]", ALL_CHAR_TYPES)
+{
+  using CharT = TestType;
+
+  static constexpr CharT sl[] = { 'a', 'B', 'a', 'Z', '@', '[', '\0' };
+  constexpr auto fs = basic_fixed_string{ sl };
+
+  SECTION("fill")
+  {
+    static constexpr CharT res[] = { 'x', 'x', 'x', 'x', 'x', 'x', '\0' };
+    static_assert([&]() {
+      auto fs_0 = fs;
+      fs_0.fill(CharT{ 'x' });
+      return c_strcmp(fs_0.c_str(), res);
+    }());
+  }
+
+  SECTION("replace")
+  {
+    static constexpr CharT res[] = { 'b', 'B', 'b', 'Z', '@', '[', '\0' };
+    static_assert([&]() {
+      auto fs_0 = fs;
+      fs_0.replace(CharT{ 'a' }, CharT{ 'b' });
+      return c_strcmp(fs_0.c_str(), res);
+    }());
+  }
+
+  SECTION("transform")
+  {
+    static constexpr CharT res[] = { 'b', 'C', 'b', '[', 'A', '\\', '\0' };
+    static_assert([&]() {
+      auto fs_0 = fs;
+      fs_0.transform([](CharT c) { return static_cast<CharT>(c + 1); });
+      return c_strcmp(fs_0.c_str(), res);
+    }());
+  }
+
+  SECTION("to_lower_inplace")
+  {
+    // '@' and '[' border the upper case range
+    static constexpr CharT res[] = { 'a', 'b', 'a', 'z', '@', '[', '\0' };
+    static_assert([&]() {
+      auto fs_0 = fs;
+      fs_0.to_lower_inplace();
+      return c_strcmp(fs_0.c_str(), res);
+    }());
+  }
+
+  SECTION("overwrite")
+  {
+    static constexpr CharT res[] = { 'a', 'B', '1', '2', '@', '[', '\0' };
+    static_assert([&]() {
+      auto fs_0 = fs;
+      fs_0.template overwrite<2>(basic_fixed_string{ CharT{ '1' }, CharT{ '2' } });
+      auto fs_1 = fs;
+      fs_1.template overwrite<0>(fs);
+      return c_strcmp(fs_0.c_str(), res) and c_strcmp(fs_1.c_str(), sl);
+    }());
+  }
+
+  SECTION("runtime")
+  {
+    CharT str[64];
+    std::fill(str, str + 64, CharT{ 'Q' });
+    auto fs_long = basic_fixed_string<CharT, 64>{ str, str + 64 };
+    fs_long.to_lower_inplace().replace(CharT{ 'q' }, CharT{ 'r' });
+    CHECK(std::all_of(fs_long.begin(), fs_long.end(), [](CharT c) { return c == CharT{ 'r' }; }));
+    CHECK(fs_long.c_str()[64] == CharT{});
+  }
+}
+
 TEMPLATE_TEST_CASE("concatenation", "[fixed_string]", ALL_CHAR_TYPES)
 {
   using CharT = TestType;
@@ -380,6 +451,51 @@ TEMPLATE_TEST_CASE("comparison", "[fixed_string]", ALL_CHAR_TYPES)
 #endif
 }
 
+TEMPLATE_TEST_CASE("runtime kernels", "[fixed_string]", ALL_CHAR_TYPES)
+{
+  using CharT = TestType;
+
+  // long enough to take the shared out-of-line paths
+  auto make = [](CharT last) {
+    CharT str[40];
+    std::fill(str, str + 40, CharT{ 'x' });
+    str[39] = last;
+    return basic_fixed_string<CharT, 40>{ str, str + 40 };
+  };
+  auto const fs_a = make(CharT{ 'a' });
+  auto const fs_b = make(CharT{ 'b' });
+
+  SECTION("equality")
+  {
+    CHECK(fs_a == make(CharT{ 'a' }));
+    CHECK(fs_a != fs_b);
+    CHECK(fs_a != basic_fixed_string{ CharT{ 'x' } });
+  }
+
+#if defined(__cpp_lib_three_way_comparison) && defined(__cpp_impl_three_way_comparison)
+  SECTION("ordering")
+  {
+    CHECK((fs_a <=> fs_b) == std::strong_ordering::less);
+    CHECK((fs_b <=> fs_a) == std::strong_ordering::greater);
+    CHECK((fs_a <=> make(CharT{ 'a' })) == std::strong_ordering::equal);
+
+    auto const fs_prefix = basic_fixed_string<CharT, 39>{ fs_a.begin(), fs_a.end() - 1 };
+    CHECK((fs_prefix <=> fs_a) == std::strong_ordering::less);
+    CHECK((fs_a <=> fs_prefix) == std::strong_ordering::greater);
+  }
+#endif
+
+  SECTION("swap")
+  {
+    auto fs_0 = fs_a;
+    auto fs_1 = fs_b;
+    fs_0.swap(fs_1);
+    CHECK(fs_0 == fs_b);
+    CHECK(fs_1 == fs_a);
+    CHECK(fs_0.c_str()[40] == CharT{});
+  }
+}
+
 TEMPLATE_TEST_CASE("hash", "[fixed_string]", ALL_CHAR_TYPES)
 {
   using CharT = TestType;
@@ -416,6 +532,11 @@ TEST_CASE("stream output", "[fixed_string]")
   std::ostringstream ss;
   ss << fs;
   CHECK(ss.str() == "Hello, World!\n");
+
+  auto const fs_long = basic_fixed_string{ "a string longer than the inline kernel size class" };
+  ss.str("");
+  ss << fs_long;
+  CHECK(ss.str() == fs_long.view());
 }
 
 #ifdef __cpp_lib_format
@@ -427,5 +548,13 @@ TEST_CASE("format", "[fixed_string]")
   auto const fs = fixed_string<14>{ "Hello, World!\n" };
 #  endif
   CHECK(std::format("{}", fs) == "Hello, World!\n");
+
+  // format specs go to the inherited `basic_string_view` formatter, for every length
+  auto const abc = basic_fixed_string{ "abc" };
+  CHECK(std::format("[{:>6}]", abc) == "[   abc]");
+  CHECK(std::format("[{:*^7.2}]", abc) == "[**ab***]");
+  auto const fs_long = basic_fixed_string{ "a string longer than the inline kernel size class" };
+  CHECK(std::format("{:.8}", fs_long) == "a string");
+  CHECK(std::format(L"{:<5}|", basic_fixed_string{ L"ab" }) == L"ab   |");
 }
 #endif
@@ -0,0 +1,123 @@
+#include <catch2/catch.hpp>
+
+#include <version>
+
+#ifdef MTP_USE_STD_MODULE
+import std;
+#else
+#  include <cstddef>
+#  include <cstdint>
+#  include <span>
+#  include <string>
+#  include <unordered_set>
+#  include <vector>
+#endif
+
+#ifdef MTP_BUILD_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/hash.hpp>
+#endif
+
+#include "random_keys.hpp"
+
+using mtp::basic_fixed_string;
+
+namespace {
+
+template <typename CharT, std::size_t N>
+auto
+make_keys(std::size_t n) -> std::vector<basic_fixed_string<CharT, N>>
+{
+  auto const letter = [](std::uint64_t x) { return 'a' + x % 26; };
+  return random_keys::make<basic_fixed_string<CharT, N>>(n, letter);
+}
+
+template <typename CharT, std::size_t N>
+auto
+check_many(std::size_t n, unsigned threads) -> void
+{
+  auto const keys = make_keys<CharT, N>(n);
+  std::vector<std::uint64_t> out(n);
+  mtp::hash_many(std::span{ keys }, std::span{ out }, threads, 42);
+  for (auto i = 0u; i < n; ++i) {
+    REQUIRE(out[i] == mtp::hash_one(keys[i], 42));
+  }
+}
+
+} // namespace
+
+TEST_CASE("hash_one", "[hash]")
+{
+  SECTION("compile time")
+  {
+    static_assert(mtp::hash_one(basic_fixed_string{ "abc" }) ==
+                  mtp::hash_one(basic_fixed_string{ "abc" }));
+    static_assert(mtp::hash_one(basic_fixed_string{ "abc" }) !=
+                  mtp::hash_one(basic_fixed_string{ "abd" }));
+    static_assert(mtp::hash_one(basic_fixed_string{ "abc" }) !=
+                  mtp::hash_one(basic_fixed_string{ "abc" }, 1));
+  }
+
+  SECTION("length is hashed")
+  {
+    // zero padding of the last word must not make "a" and "a\0" collide
+    auto const a = basic_fixed_string{ "a" };
+    auto const b = basic_fixed_string<char, 2>{ "a\0" };
+    REQUIRE(mtp::hash_one(a) != mtp::hash_one(b));
+    REQUIRE(mtp::hash_one(basic_fixed_string{ "" }) != mtp::hash_one(basic_fixed_string{ "\0" }));
+  }
+
+  SECTION("wide characters")
+  {
+    REQUIRE(mtp::hash_one(basic_fixed_string{ U"abc" }) !=
+            mtp::hash_one(basic_fixed_string{ U"abd" }));
+    REQUIRE(mtp::hash_one(basic_fixed_string{ u"\xFFFF" }) !=
+            mtp::hash_one(basic_fixed_string{ u"\xFFFE" }));
+  }
+
+  SECTION("distribution")
+  {
+    auto const keys = make_keys<char, 12>(10000);
+    std::unordered_set<std::uint64_t> seen;
+    std::unordered_set<std::string> distinct;
+    for (auto const& k : keys) {
+      seen.insert(mtp::hash_one(k));
+      distinct.insert(std::string{ k.view() });
+    }
+    REQUIRE(seen.size() == distinct.size());
+  }
+}
+
+TEST_CASE("hash_many", "[hash]")
+{
+  SECTION("matches hash_one")
+  {
+    // sizes around the lane count exercise the scalar tail
+    for (auto n : { 0u, 1u, 7u, 8u, 9u, 31u, 1000u }) {
+      check_many<char, 1>(n, 1);
+      check_many<char, 8>(n, 1);
+      check_many<char, 13>(n, 1);
+      check_many<char, 40>(n, 1);
+      check_many<char16_t, 5>(n, 1);
+      check_many<char32_t, 9>(n, 1);
+    }
+  }
+
+  SECTION("threaded")
+  {
+    check_many<char, 16>((std::size_t{ 1 } << 17) + 13, 0);
+    check_many<char, 16>((std::size_t{ 1 } << 18) + 3, 3);
+    // size / threads is a multiple of the lane count, with a remainder left for the last chunk
+    check_many<char, 16>(3 * (std::size_t{ 1 } << 16) + 1, 3);
+    check_many<char, 16>(4 * (std::size_t{ 1 } << 16) + 3, 4);
+  }
+
+  SECTION("mutable span")
+  {
+    auto keys = make_keys<char, 6>(20);
+    std::vector<std::uint64_t> out(keys.size());
+    mtp::hash_many(std::span{ keys }, std::span{ out });
+    REQUIRE(out[19] == mtp::hash_one(keys[19]));
+  }
+}
@@ -0,0 +1,112 @@
+#include <catch2/catch.hpp>
+
+#include <version>
+
+#ifdef MTP_USE_STD_MODULE
+import std;
+#else
+#  include <cstddef>
+#  include <functional>
+#  include <string>
+#  include <string_view>
+#  include <thread>
+#  include <vector>
+#endif
+
+#ifdef MTP_BUILD_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/interner.hpp>
+#endif
+
+using mtp::basic_fixed_string;
+
+TEST_CASE("interner", "[interner]")
+{
+  auto in = mtp::interner{};
+
+  SECTION("unique handles")
+  {
+    auto const a = in.intern("AAPL");
+    auto const b = in.intern(std::string{ "AAPL" });
+    auto const c = in.intern("MSFT");
+    CHECK(a == b);
+    CHECK(a != c);
+    CHECK(a.data() == b.data());
+    CHECK(a.view() == "AAPL");
+    CHECK(a.c_str()[a.size()] == '\0');
+    CHECK(in.size() == 2);
+  }
+
+  SECTION("find")
+  {
+    CHECK(not in.find("IBM"));
+    auto const h = in.intern("IBM");
+    CHECK(in.find("IBM") == h);
+    CHECK(in.find(std::string_view{}) == mtp::interned{});
+  }
+
+  SECTION("empty string")
+  {
+    auto const h = in.intern("");
+    CHECK(h);
+    CHECK(h.size() == 0);
+    CHECK(in.intern(std::string_view{}) == h);
+  }
+
+  SECTION("fixed_string interop")
+  {
+    auto const h = in.intern(basic_fixed_string{ "TSLA" });
+    CHECK(h == in.intern("TSLA"));
+    CHECK(h.to_fixed_string<4>() == basic_fixed_string{ "TSLA" });
+  }
+
+  SECTION("hash")
+  {
+    auto const h = in.intern("NVDA");
+    CHECK(std::hash<mtp::interned>{}(h) == std::hash<std::string_view>{}("NVDA"));
+  }
+
+  SECTION("growth keeps handles stable")
+  {
+    auto const first = in.intern("sym0");
+    auto const* first_data = first.data();
+    for (auto i = 0; i < 10'000; ++i) {
+      in.intern("sym" + std::to_string(i));
+    }
+    CHECK(in.size() == 10'000);
+    CHECK(in.find("sym0") == first);
+    CHECK(first.data() == first_data);
+    CHECK(in.find("sym9999").view() == "sym9999");
+  }
+}
+
+TEST_CASE("interner concurrent inserts", "[interner]")
+{
+  constexpr auto thread_count = 8;
+  constexpr auto symbol_count = 2'000;
+
+  auto in = mtp::interner{};
+  std::vector<std::vector<mtp::interned>> results(thread_count);
+  std::vector<std::thread> threads;
+  for (auto t = 0; t < thread_count; ++t) {
+    threads.emplace_back([&, t] {
+      for (auto i = 0; i < symbol_count; ++i) {
+        // every thread interns the same symbols in a different order
+        auto const n = (i * 7 + t * 13) % symbol_count;
+        results[t].push_back(in.intern("sym" + std::to_string(n)));
+      }
+    });
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+
+  CHECK(in.size() == symbol_count);
+  for (auto t = 0; t < thread_count; ++t) {
+    for (auto i = 0; i < symbol_count; ++i) {
+      auto const n = (i * 7 + t * 13) % symbol_count;
+      REQUIRE(results[t][i] == in.find("sym" + std::to_string(n)));
+    }
+  }
+}
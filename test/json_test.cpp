@@ -0,0 +1,168 @@
+#include <catch2/catch.hpp>
+
+#include <version>
+
+#ifdef MTP_USE_STD_MODULE
+import std;
+#else
+#  include <cstddef>
+#  include <cstdint>
+#  include <cstdio>
+#  include <limits>
+#  include <string>
+#  include <string_view>
+#endif
+
+#ifdef MTP_BUILD_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/json.hpp>
+#endif
+
+#if __cpp_nontype_template_args >= 201911L
+
+using namespace std::string_view_literals;
+
+namespace {
+
+template <auto Name>
+concept strict_key = requires { mtp::json::key<Name, mtp::json::key_mode::strict>; };
+
+// reference escaping, one character at a time
+auto
+naive_escape(std::string_view str) -> std::string
+{
+  std::string out;
+  for (auto c : str) {
+    switch (c) {
+      case '"': out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\b': out += "\\b"; break;
+      case '\f': out += "\\f"; break;
+      case '\n': out += "\\n"; break;
+      case '\r': out += "\\r"; break;
+      case '\t': out += "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char buf[8];
+          std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+          out += buf;
+        } else {
+          out += c;
+        }
+    }
+  }
+  return out;
+}
+
+} // namespace
+
+TEST_CASE("json fragments", "[json]")
+{
+  SECTION("keys")
+  {
+    static_assert(mtp::json::key<"name"> == "\"name\":");
+    static_assert(mtp::json::key<"name">.size() == 7);
+    static_assert(mtp::json::key<"a\"b"> == "\"a\\\"b\":");
+    static_assert(mtp::json::key<"tab\there"> == "\"tab\\there\":");
+    static_assert(mtp::json::key<"\x01"> == "\"\\u0001\":");
+    static_assert(mtp::json::key<""> == "\"\":");
+  }
+
+  SECTION("strict keys")
+  {
+    static_assert(mtp::json::key<"price", mtp::json::key_mode::strict> == "\"price\":");
+    static_assert(strict_key<mtp::basic_fixed_string{ "ok_name" }>);
+    static_assert(!strict_key<mtp::basic_fixed_string{ "quo\"te" }>);
+    static_assert(!strict_key<mtp::basic_fixed_string{ "new\nline" }>);
+  }
+
+  SECTION("quoted values")
+  {
+    static_assert(mtp::json::quoted<"buy"> == "\"buy\"");
+    static_assert(mtp::json::quoted<"C:\\dir"> == "\"C:\\\\dir\"");
+  }
+}
+
+TEST_CASE("json writer", "[json]")
+{
+  SECTION("document")
+  {
+    auto w = mtp::json::writer{ 256 };
+    w.begin_object()
+      .member<"id">(42)
+      .member<"symbol">("AAPL"sv)
+      .member<"price">(187.25)
+      .member<"open">(true)
+      .member<"note">(nullptr);
+    w.key<"fills">().begin_array().value(1).value(-2).begin_object().end_object().end_array();
+    w.key<"side">().value<"buy">();
+    w.key("dyn\"key").value(std::uint64_t{ 7 });
+    w.end_object();
+    REQUIRE(w.view() == R"({"id":42,"symbol":"AAPL","price":187.25,"open":true,"note":null,)"
+                        R"("fills":[1,-2,{}],"side":"buy","dyn\"key":7})");
+  }
+
+  SECTION("reuse")
+  {
+    auto w = mtp::json::writer{};
+    w.begin_array().value(1).end_array();
+    w.clear();
+    w.begin_array().value(2).end_array();
+    REQUIRE(w.view() == "[2]");
+    w.clear();
+    w.value(1).value(2);
+    REQUIRE(w.view() == "1,2");
+  }
+
+  SECTION("characters")
+  {
+    auto w = mtp::json::writer{};
+    w.begin_array().value('a').value('"').value(std::int8_t{ 97 }).end_array();
+    REQUIRE(w.view() == R"(["a","\"",97])");
+  }
+
+  SECTION("null C strings")
+  {
+    char const* none = nullptr;
+    auto w = mtp::json::writer{};
+    w.begin_array().value(none).value("x").end_array();
+    REQUIRE(w.view() == R"([null,"x"])");
+  }
+
+  SECTION("non-finite numbers")
+  {
+    auto w = mtp::json::writer{};
+    w.begin_array()
+      .value(std::numeric_limits<double>::infinity())
+      .value(std::numeric_limits<double>::quiet_NaN())
+      .value(0.5f)
+      .end_array();
+    REQUIRE(w.view() == "[null,null,0.5]");
+  }
+
+  SECTION("escaping matches a scalar reference")
+  {
+    // every byte value at every offset around the 16-byte blocks
+    for (auto len : { 1u, 15u, 16u, 17u, 33u, 64u }) {
+      for (auto pos = 0u; pos < len; ++pos) {
+        for (auto b = 0u; b < 256; b += 1) {
+          auto str = std::string(len, 'x');
+          str[pos] = static_cast<char>(b);
+          auto w = mtp::json::writer{};
+          w.value(str);
+          REQUIRE(w.view() == std::string{ "\"" }.append(naive_escape(str)).append("\""));
+        }
+      }
+    }
+  }
+
+  SECTION("escaping runs")
+  {
+    auto w = mtp::json::writer{};
+    w.value("line one\nline \"two\"\t\\ end\x1f\x7f\xc3\xa9"sv);
+    REQUIRE(w.view() == "\"line one\\nline \\\"two\\\"\\t\\\\ end\\u001f\x7f\xc3\xa9\"");
+  }
+}
+
+#endif
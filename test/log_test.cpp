@@ -0,0 +1,210 @@
+#include <catch2/catch.hpp>
+
+#include <version>
+
+#ifdef MTP_USE_STD_MODULE
+import std;
+#else
+#  include <cstddef>
+#  include <cstdint>
+#  include <span>
+#  include <string>
+#  include <string_view>
+#  include <system_error>
+#  include <thread>
+#  include <utility>
+#  include <vector>
+#endif
+
+#ifdef MTP_BUILD_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/log.hpp>
+#endif
+
+#if __cpp_nontype_template_args >= 201911L
+
+using mtp::basic_fixed_string;
+using namespace std::string_view_literals;
+
+namespace {
+
+template <basic_fixed_string Fmt, typename... Args>
+concept loggable = requires(Args... args) { mtp::log<Fmt>(args...); };
+
+// drains the process-wide backend into one binary log
+auto
+drain() -> std::vector<std::byte>
+{
+  std::vector<std::byte> bytes;
+  mtp::log_backend::instance().poll([&](std::span<std::byte const> chunk) {
+    bytes.insert(bytes.end(), chunk.begin(), chunk.end());
+  });
+  return bytes;
+}
+
+auto
+decode(std::span<std::byte const> bytes) -> std::vector<std::pair<std::uint32_t, std::string>>
+{
+  std::vector<std::pair<std::uint32_t, std::string>> lines;
+  mtp::log_decoder decoder;
+  decoder.feed(bytes, [&](std::uint32_t thread, std::string_view line) {
+    lines.emplace_back(thread, std::string{ line });
+  });
+  REQUIRE(decoder.complete());
+  return lines;
+}
+
+} // namespace
+
+TEST_CASE("log", "[log]")
+{
+  drain(); // discard records from other test cases
+
+  SECTION("format checks")
+  {
+    static_assert(loggable<"a {} b {}", int, int>);
+    static_assert(!loggable<"a {} b {}", int>);
+    static_assert(loggable<"{{}} {}", int>);
+    static_assert(!loggable<"{{}} {}", int, int>);
+    static_assert(!loggable<"{ }">);
+    static_assert(!loggable<"{ }", int>);
+    static_assert(loggable<"{} {}", int, double>);
+    static_assert(!loggable<"{}", int, int>);
+    static_assert(!loggable<"{} {}", int, std::vector<int>>);
+  }
+
+  SECTION("round trip")
+  {
+    auto const sym = std::string{ "AAPL" };
+    mtp::log<"order {} filled at {}">(42, 187.25);
+    mtp::log<"{} {} {} {} {}">(true, 'x', -7, std::uint64_t{ 18446744073709551615u }, 1.5f);
+    mtp::log<"sym={} note={} fs={}">(sym, "quoted \"text\"", basic_fixed_string{ "fixed" });
+    mtp::log<"{{literal}} {}">(""sv);
+    mtp::log<"no arguments">();
+
+    auto const lines = decode(drain());
+    REQUIRE(lines.size() == 5);
+    REQUIRE(lines[0].second == "order 42 filled at 187.25");
+    REQUIRE(lines[1].second == "true x -7 18446744073709551615 1.5");
+    REQUIRE(lines[2].second == "sym=AAPL note=quoted \"text\" fs=fixed");
+    REQUIRE(lines[3].second == "{literal} ");
+    REQUIRE(lines[4].second == "no arguments");
+    REQUIRE(lines[0].first == lines[4].first);
+  }
+
+  SECTION("null strings")
+  {
+    char const* none = nullptr;
+    mtp::log<"[{}] [{}]">(none, "x");
+    auto const lines = decode(drain());
+    REQUIRE(lines.size() == 1);
+    REQUIRE(lines[0].second == "[] [x]");
+  }
+
+  SECTION("logging after the ring is retired")
+  {
+    std::thread{ [] {
+      // destroyed after the thread's ring, which is created by the first record below
+      thread_local struct at_exit
+      {
+        ~at_exit()
+        {
+          mtp::log<"too late">();
+        }
+      } late;
+      static_cast<void>(late);
+      mtp::log<"in time">();
+    } }.join();
+    auto const lines = decode(drain());
+    REQUIRE(lines.size() == 1);
+    REQUIRE(lines[0].second == "in time");
+  }
+
+  SECTION("formats are described once")
+  {
+    for (auto i = 0; i < 3; ++i) {
+      mtp::log<"repeat {}">(i);
+    }
+    auto first = drain();
+    mtp::log<"repeat {}">(3);
+    auto second = drain();
+    REQUIRE(second.size() < first.size() / 2);
+
+    // the second chunk relies on the description in the first
+    first.insert(first.end(), second.begin(), second.end());
+    auto const lines = decode(first);
+    REQUIRE(lines.size() == 4);
+    REQUIRE(lines[3].second == "repeat 3");
+
+    std::errc ec{};
+    mtp::log_decoder fresh;
+    fresh.feed(second, [](std::uint32_t, std::string_view) {}, ec);
+    REQUIRE(ec == std::errc::illegal_byte_sequence);
+  }
+
+  SECTION("decoding in pieces")
+  {
+    for (auto i = 0; i < 100; ++i) {
+      mtp::log<"piece {} of {}">(i, "one hundred"sv);
+    }
+    auto const bytes = drain();
+    mtp::log_decoder decoder;
+    std::vector<std::string> lines;
+    for (std::size_t at = 0; at < bytes.size(); at += 7) {
+      auto const n = bytes.size() - at < 7 ? bytes.size() - at : 7;
+      decoder.feed(std::span{ bytes }.subspan(at, n),
+                   [&](std::uint32_t, std::string_view line) { lines.emplace_back(line); });
+    }
+    REQUIRE(decoder.complete());
+    REQUIRE(lines.size() == 100);
+    REQUIRE(lines[99] == "piece 99 of one hundred");
+  }
+
+  SECTION("threads")
+  {
+    constexpr int per_thread = 2000;
+    auto& backend = mtp::log_backend::instance();
+    auto const dropped_before = backend.dropped();
+    backend.set_ring_capacity(4096);
+    std::vector<std::thread> threads;
+    for (auto t = 0; t < 4; ++t) {
+      threads.emplace_back([t] {
+        for (auto i = 0; i < per_thread; ++i) {
+          mtp::log<"thread {} message {}">(t, i);
+        }
+      });
+    }
+    // drain concurrently with the producers, wrapping the rings many times
+    std::vector<std::byte> bytes;
+    auto collect = [&] {
+      backend.poll([&](std::span<std::byte const> chunk) {
+        bytes.insert(bytes.end(), chunk.begin(), chunk.end());
+      });
+    };
+    for (auto i = 0; i < 50; ++i) {
+      collect();
+      std::this_thread::yield();
+    }
+    for (auto& th : threads) {
+      th.join();
+    }
+    collect();
+    backend.set_ring_capacity(std::size_t{ 1 } << 20);
+
+    // full rings drop records but never lose count of them
+    auto const lines = decode(bytes);
+    REQUIRE(lines.size() + (backend.dropped() - dropped_before) == 4 * per_thread);
+
+    // per thread, messages arrive in order
+    int next[4] = {};
+    for (auto const& [thread, line] : lines) {
+      auto const t = line[7] - '0';
+      auto const i = std::stoi(line.substr(line.rfind(' ') + 1));
+      REQUIRE(i >= next[t]);
+      next[t] = i + 1;
+    }
+  }
+}
+
+#endif
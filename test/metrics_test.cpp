@@ -0,0 +1,142 @@
+#include <catch2/catch.hpp>
+
+#include <version>
+
+#ifdef MTP_USE_STD_MODULE
+import std;
+#else
+#  include <cstdint>
+#  include <string>
+#  include <thread>
+#  include <utility>
+#  include <vector>
+#endif
+
+#ifdef MTP_BUILD_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/metrics.hpp>
+#endif
+
+#if __cpp_nontype_template_args >= 201911L
+
+namespace {
+
+template <std::size_t I>
+constexpr auto overflow_name =
+  mtp::basic_fixed_string<char, 4>{ 'o', 'v', static_cast<char>('0' + I / 10),
+                                    static_cast<char>('0' + I % 10) };
+
+auto
+counter_value(char const* name) -> std::uint64_t
+{
+  auto const snap = mtp::metrics_registry::instance().collect();
+  auto const* c = snap.counter(name);
+  return c == nullptr ? 0 : c->value;
+}
+
+} // namespace
+
+TEST_CASE("metrics", "[metrics]")
+{
+  SECTION("slots are dense and stable")
+  {
+    auto const a = mtp::counter<"test.a">::slot();
+    auto const b = mtp::counter<"test.b">::slot();
+    auto const h = mtp::histogram<"test.h">::slot();
+    auto const c = mtp::counter<"test.c">::slot();
+    REQUIRE(mtp::counter<"test.a">::slot() == a);
+    REQUIRE(b == a + mtp::counter<"test.a">::cells);
+    REQUIRE(c == h + mtp::histogram<"test.h">::cells);
+    static_assert(mtp::counter<"test.a">::name == "test.a");
+  }
+
+  SECTION("counters")
+  {
+    auto const before = counter_value("test.requests");
+    mtp::counter<"test.requests">::add();
+    mtp::counter<"test.requests">::add(41);
+    REQUIRE(counter_value("test.requests") - before == 42);
+    REQUIRE(counter_value("test.missing") == 0);
+  }
+
+  SECTION("histograms")
+  {
+    for (std::uint64_t v : { 0, 1, 3, 3, 100, 1000 }) {
+      mtp::histogram<"test.latency_us">::record(v);
+    }
+    auto const snap = mtp::metrics_registry::instance().collect();
+    auto const* h = snap.histogram("test.latency_us");
+    REQUIRE(h != nullptr);
+    REQUIRE(h->count == 6);
+    REQUIRE(h->sum == 1107);
+    REQUIRE(h->buckets[0] == 1);
+    REQUIRE(h->buckets[2] == 2);
+    REQUIRE(h->quantile(0.0) == 0);
+    REQUIRE(h->quantile(0.5) == 3);
+    REQUIRE(h->quantile(1.0) == 1023);
+  }
+
+  SECTION("text snapshot")
+  {
+    mtp::counter<"test.text">::add(7);
+    mtp::histogram<"test.text_us">::record(5);
+    auto const text = mtp::metrics_registry::instance().collect().text();
+    REQUIRE(text.find("test.text 7\n") != std::string::npos);
+    REQUIRE(text.find("test.text_us.count 1\n") != std::string::npos);
+    REQUIRE(text.find("test.text_us.sum 5\n") != std::string::npos);
+    REQUIRE(text.find("test.text_us.p99 7\n") != std::string::npos);
+  }
+
+  SECTION("threads")
+  {
+    constexpr int per_thread = 10000;
+    auto const before = counter_value("test.threads");
+    std::vector<std::thread> threads;
+    for (auto t = 0; t < 8; ++t) {
+      threads.emplace_back([] {
+        for (auto i = 0; i < per_thread; ++i) {
+          mtp::counter<"test.threads">::add();
+        }
+      });
+    }
+    // collecting concurrently sees a partial count, never more than the total
+    REQUIRE(counter_value("test.threads") - before <= 8 * per_thread);
+    for (auto& th : threads) {
+      th.join();
+    }
+    // exited threads are folded into the totals
+    REQUIRE(counter_value("test.threads") - before == 8 * per_thread);
+  }
+
+  SECTION("names are unique")
+  {
+    auto& registry = mtp::metrics_registry::instance();
+    auto const rejected = registry.rejected();
+    mtp::counter<"test.dup">::add(3);
+    mtp::histogram<"test.dup">::record(5);
+    REQUIRE(registry.rejected() == rejected + 1);
+
+    auto const snap = registry.collect();
+    REQUIRE(snap.counter("test.dup")->value == 3);
+    REQUIRE(snap.histogram("test.dup") == nullptr);
+  }
+
+  // runs last: afterwards the shards are full
+  SECTION("overflow")
+  {
+    auto& registry = mtp::metrics_registry::instance();
+    auto const rejected = registry.rejected();
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+      (mtp::histogram<overflow_name<I>>::record(I), ...);
+    }(std::make_index_sequence<70>{});
+
+    auto const snap = registry.collect();
+    REQUIRE(registry.rejected() > rejected);
+    REQUIRE(snap.histogram("ov00") != nullptr);
+    REQUIRE(snap.histogram("ov69") == nullptr);
+    REQUIRE(snap.counter("test.requests") != nullptr);
+  }
+}
+
+#endif
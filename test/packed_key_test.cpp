@@ -0,0 +1,120 @@
+#include <catch2/catch.hpp>
+
+#include <version>
+
+#ifdef MTP_USE_STD_MODULE
+import std;
+#else
+#  include <compare>
+#  include <cstddef>
+#  include <cstdint>
+#  include <functional>
+#  include <vector>
+#endif
+
+#ifdef MTP_BUILD_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/packed_key.hpp>
+#endif
+
+#include "random_keys.hpp"
+
+using mtp::basic_fixed_string;
+using mtp::packed_key;
+
+namespace {
+
+// keys over every byte value, including '\0' and bytes >= 0x80; mostly a few values, so that long
+// common prefixes occur
+template <std::size_t N>
+auto
+make_keys(std::size_t n) -> std::vector<basic_fixed_string<char, N>>
+{
+  return random_keys::make<basic_fixed_string<char, N>>(n, [](std::uint64_t x) {
+    return x % 4 == 0 ? static_cast<char>(x >> 8) : "\0Aa\xff"[x % 4];
+  });
+}
+
+template <std::size_t N>
+auto
+check() -> void
+{
+  auto const keys = make_keys<N>(512);
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    auto const a = packed_key{ keys[i] };
+    REQUIRE(a.unpack() == keys[i]);
+    REQUIRE(packed_key<N>::from_bits(a.bits()) == a);
+    auto const& other = keys[(i * 7 + 1) % keys.size()];
+    auto const b = packed_key{ other };
+    REQUIRE((a <=> b) == (keys[i] <=> other));
+    REQUIRE((a == b) == (keys[i] == other));
+    if (a == b) {
+      REQUIRE(std::hash<packed_key<N>>{}(a) == std::hash<packed_key<N>>{}(b));
+    }
+  }
+}
+
+} // namespace
+
+TEST_CASE("packed_key", "[packed_key]")
+{
+  SECTION("representation")
+  {
+    static_assert(sizeof(packed_key<8>) == sizeof(std::uint64_t));
+    static_assert(packed_key<4>::size == 4);
+    REQUIRE(packed_key{ basic_fixed_string{ "AB" } }.bits() == 0x4142000000000000u);
+    REQUIRE(packed_key<3>{}.unpack() == basic_fixed_string<char, 3>{ '\0', '\0', '\0' });
+  }
+
+  SECTION("round trip and order")
+  {
+    check<0>();
+    check<1>();
+    check<5>();
+    check<8>();
+#ifdef __SIZEOF_INT128__
+    check<9>();
+    check<16>();
+#endif
+  }
+
+  SECTION("hash")
+  {
+    auto const keys = make_keys<8>(4096);
+    std::vector<std::size_t> hashes;
+    for (auto const& k : keys) {
+      hashes.push_back(std::hash<packed_key<8>>{}(packed_key{ k }));
+    }
+    // no systematic collisions in the low bits used by power-of-two tables
+    std::vector<int> buckets(1024);
+    for (auto h : hashes) {
+      ++buckets[h % buckets.size()];
+    }
+    for (auto b : buckets) {
+      REQUIRE(b < 20);
+    }
+
+#ifdef __SIZEOF_INT128__
+    // a multiply-only mix sent every key whose low word matched its constant to 0
+    auto const a = basic_fixed_string{ "ABCDEFGH\x9e\x37\x79\xb9\x7f\x4a\x7c\x15" };
+    auto const b = basic_fixed_string{ "abcdefgh\x9e\x37\x79\xb9\x7f\x4a\x7c\x15" };
+    REQUIRE(std::hash<packed_key<16>>{}(packed_key{ a }) !=
+            std::hash<packed_key<16>>{}(packed_key{ b }));
+#endif
+  }
+
+#if __cpp_nontype_template_args >= 201911L
+  SECTION("constant keys")
+  {
+    static_assert(mtp::pack<"AAPL"> < mtp::pack<"MSFT">);
+    static_assert(mtp::pack<"AAPL">.unpack() == "AAPL");
+    static_assert(mtp::pack<"AAPL"> == packed_key{ basic_fixed_string{ "AAPL" } });
+    static_assert(std::hash<packed_key<4>>{}(mtp::pack<"AAPL">) != 0);
+#  ifdef __SIZEOF_INT128__
+    static_assert(mtp::pack<"XNAS.ITCH.AAPL"> < mtp::pack<"XNAS.ITCH.MSFT">);
+    static_assert(mtp::pack<"0123456789abcdef">.unpack() == "0123456789abcdef");
+#  endif
+  }
+#endif
+}
@@ -0,0 +1,93 @@
+#include <catch2/catch.hpp>
+
+#include <version>
+
+#ifdef MTP_USE_STD_MODULE
+import std;
+#else
+#  include <algorithm>
+#  include <cstddef>
+#  include <cstdint>
+#  if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+#    include <stdexcept>
+#  endif
+#  include <system_error>
+#  include <utility>
+#endif
+
+#ifdef MTP_BUILD_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/parse.hpp>
+#endif
+
+using mtp::basic_fixed_string;
+
+TEST_CASE("parse", "[parse]")
+{
+  SECTION("compile time")
+  {
+    static_assert(mtp::parse<std::uint64_t>(basic_fixed_string{ "7" }) == 7);
+    static_assert(mtp::parse<std::uint64_t>(basic_fixed_string{ "00001234" }) == 1234);
+    static_assert(mtp::parse<std::uint64_t>(basic_fixed_string{ "987654321" }) == 987654321);
+    static_assert(mtp::parse<std::uint64_t>(basic_fixed_string{ "123456789012" }) ==
+                  123456789012);
+    static_assert(mtp::parse<std::uint64_t>(basic_fixed_string{ "9999999999999999999" }) ==
+                  9999999999999999999u);
+    static_assert(mtp::parse<std::uint32_t>(basic_fixed_string{ "4294967" }) == 4294967);
+    static_assert(mtp::parse<std::uint64_t>(mtp::fixed_string<0>{}) == 0);
+  }
+
+  SECTION("every width")
+  {
+    auto const fs = basic_fixed_string{ "1234567890123456789" };
+    std::uint64_t expected = 0;
+    auto check = [&]<std::size_t N>(mtp::fixed_string<N> const& f) {
+      std::errc ec{};
+      CHECK(mtp::parse<std::uint64_t>(f, ec) == expected);
+      CHECK(ec == std::errc{});
+    };
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      ((expected = expected * 10 + fs[Is],
+        expected -= '0',
+        check(mtp::fixed_string<Is + 1>{ fs.begin(), fs.begin() + Is + 1 })),
+       ...);
+    }(std::make_index_sequence<19>{});
+  }
+
+  SECTION("invalid characters")
+  {
+    std::errc ec{};
+    for (auto bad : { ' ', '/', ':', 'a', '\0', '\x80', '\xff' }) {
+      for (auto pos = 0u; pos < 12; ++pos) {
+        char str[12];
+        std::fill(str, str + 12, '5');
+        str[pos] = bad;
+        static_cast<void>(mtp::parse<std::uint64_t>(mtp::fixed_string<12>{ str, str + 12 }, ec));
+        REQUIRE(ec == std::errc::invalid_argument);
+      }
+    }
+
+#if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+    CHECK_THROWS_AS(mtp::parse<std::uint64_t>(basic_fixed_string{ "12x4" }), std::invalid_argument);
+#endif
+  }
+
+  SECTION("decimal")
+  {
+    static_assert(mtp::parse_decimal<4>(basic_fixed_string{ "000187.2500" }) == 1872500);
+    static_assert(mtp::parse_decimal<2>(basic_fixed_string{ "12.34" }) == 1234);
+    static_assert(mtp::parse_decimal<3>(basic_fixed_string{ ".125" }) == 125);
+    static_assert(mtp::parse_decimal<0>(basic_fixed_string{ "42." }) == 42);
+    static_assert(mtp::parse_decimal<6, std::uint32_t>(basic_fixed_string{ "1.000001" }) ==
+                  1000001);
+
+    std::errc ec{};
+    static_cast<void>(mtp::parse_decimal<4>(basic_fixed_string{ "000187,2500" }, ec));
+    CHECK(ec == std::errc::invalid_argument);
+    static_cast<void>(mtp::parse_decimal<4>(basic_fixed_string{ "000187.25x0" }, ec));
+    CHECK(ec == std::errc::invalid_argument);
+    CHECK(mtp::parse_decimal<4>(basic_fixed_string{ "123456.7890" }, ec) == 1234567890);
+    CHECK(ec == std::errc{});
+  }
+}
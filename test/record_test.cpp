@@ -0,0 +1,97 @@
+#include <catch2/catch.hpp>
+
+#include <version>
+
+#ifdef MTP_USE_STD_MODULE
+import std;
+#else
+#  include <array>
+#  include <cstdint>
+#  include <span>
+#  if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+#    include <stdexcept>
+#  endif
+#  include <string_view>
+#  include <system_error>
+#  include <type_traits>
+#endif
+
+#ifdef MTP_BUILD_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/record.hpp>
+#endif
+
+#if __cpp_nontype_template_args >= 201911L // class type NTTPs
+
+namespace {
+
+using trade = mtp::record<mtp::field<"symbol", 8>,
+                          mtp::field<"qty", 10, std::uint64_t>,
+                          mtp::field<"side", 1>,
+                          mtp::field<"price", 12, std::uint64_t>>;
+
+} // namespace
+
+TEST_CASE("record", "[record]")
+{
+  SECTION("layout")
+  {
+    static_assert(trade::size() == 31);
+    static_assert(trade::offset_of<"symbol"> == 0);
+    static_assert(trade::offset_of<"qty"> == 8);
+    static_assert(trade::offset_of<"side"> == 18);
+    static_assert(trade::offset_of<"price"> == 19);
+    static_assert(std::is_same_v<trade::type_of<"qty">, std::uint64_t>);
+    static_assert(std::is_same_v<trade::type_of<"symbol">, std::string_view>);
+    static_assert(std::is_trivially_copyable_v<trade> && sizeof(trade) == sizeof(char const*));
+  }
+
+  SECTION("overlay")
+  {
+    static constexpr char buf[] = "AAPL    0000001500B000018725000";
+    constexpr auto rec = trade{ buf };
+    static_assert(rec.get<"symbol">() == "AAPL    ");
+    static_assert(rec.get<"qty">() == 1500);
+    static_assert(rec.get<"side">() == "B");
+    static_assert(rec.get<"price">() == 18725000);
+    CHECK(rec.raw<"qty">().data() == buf + 8);
+  }
+
+  SECTION("invalid numeric field")
+  {
+    char const buf[] = "AAPL    00000015x0B000018725000";
+    auto const rec = trade{ buf };
+    std::errc ec{};
+    static_cast<void>(rec.get<"qty">(ec));
+    CHECK(ec == std::errc::invalid_argument);
+    static_cast<void>(rec.get<"price">(ec));
+    CHECK(ec == std::errc{});
+#if !defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
+    CHECK_THROWS_AS(rec.get<"qty">(), std::invalid_argument);
+#endif
+  }
+
+  SECTION("columnar decoding")
+  {
+    constexpr std::string_view feed = "AAPL    0000001500B000018725000\n"
+                                      "MSFT    0000000200S000041150000\n"
+                                      "IBM     0000000010B000017000500";
+    CHECK(trade::count(feed, trade::size() + 1) == 3);
+    CHECK(trade::count(feed.substr(0, 30), trade::size() + 1) == 0);
+
+    std::array<std::uint64_t, 3> qty{};
+    std::array<std::string_view, 3> symbols{};
+    std::errc ec{};
+    CHECK(trade::decode_column<"qty">(feed, qty, ec, trade::size() + 1) == 3);
+    CHECK(ec == std::errc{});
+    CHECK(qty == std::array<std::uint64_t, 3>{ 1500, 200, 10 });
+    CHECK(trade::decode_column<"symbol">(feed, symbols, ec, trade::size() + 1) == 3);
+    CHECK(symbols[2] == "IBM     ");
+
+    CHECK(trade::decode_column<"qty">({}, std::span<std::uint64_t>{}, ec) == 0);
+    CHECK(ec == std::errc{});
+  }
+}
+
+#endif
@@ -0,0 +1,121 @@
+#include <catch2/catch.hpp>
+
+#include <version>
+
+#ifdef MTP_USE_STD_MODULE
+import std;
+#else
+#  include <cstddef>
+#  include <string>
+#  include <string_view>
+#endif
+
+#ifdef MTP_BUILD_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/router.hpp>
+#endif
+
+#if __cpp_nontype_template_args >= 201911L
+
+using namespace std::string_view_literals;
+
+namespace {
+
+using api = mtp::prefix_router<"/api/", "/api/v2/", "/api/v2/orders/", "/health", "/api/v2/order",
+                               "/static/assets/images/", "/static/">;
+
+// reference implementation: longest route that is a prefix
+template <typename Router>
+auto
+naive(std::string_view path) -> mtp::route_match
+{
+  auto best = mtp::route_match{ mtp::route_match::npos, path };
+  std::size_t best_len = 0;
+  for (auto i = 0u; i < Router::size(); ++i) {
+    auto const r = Router::route(i);
+    if (path.starts_with(r) && (best.index == mtp::route_match::npos || r.size() > best_len)) {
+      best = mtp::route_match{ i, path.substr(r.size()) };
+      best_len = r.size();
+    }
+  }
+  return best;
+}
+
+} // namespace
+
+TEST_CASE("prefix_router", "[router]")
+{
+  SECTION("compile time")
+  {
+    static_assert(api::size() == 7);
+    static_assert(api::match("/api/v2/orders/42").index == 2);
+    static_assert(api::match("/api/v2/orders/42").suffix == "42"sv);
+    static_assert(api::match("/api/v1/users").index == 0);
+    static_assert(!api::match("/apx"));
+  }
+
+  SECTION("longest prefix wins")
+  {
+    auto m = api::match("/api/v2/orders/42");
+    REQUIRE(m);
+    REQUIRE(m.index == 2);
+    REQUIRE(m.suffix == "42");
+
+    m = api::match("/api/v2/orderbook");
+    REQUIRE(m.index == 4);
+    REQUIRE(m.suffix == "book");
+
+    m = api::match("/api/v2/");
+    REQUIRE(m.index == 1);
+    REQUIRE(m.suffix.empty());
+
+    m = api::match("/api/v2");
+    REQUIRE(m.index == 0);
+    REQUIRE(m.suffix == "v2");
+
+    m = api::match("/static/assets/images/logo.png");
+    REQUIRE(m.index == 5);
+    REQUIRE(m.suffix == "logo.png");
+
+    m = api::match("/static/assets/imagex/logo.png");
+    REQUIRE(m.index == 6);
+    REQUIRE(m.suffix == "assets/imagex/logo.png");
+  }
+
+  SECTION("no match")
+  {
+    for (auto path : { ""sv, "/"sv, "/ap"sv, "/api"sv, "/healt"sv, "api/"sv }) {
+      auto const m = api::match(path);
+      REQUIRE_FALSE(m);
+      REQUIRE(m.suffix == path);
+    }
+  }
+
+  SECTION("empty route is the default")
+  {
+    using r = mtp::prefix_router<"", "/a">;
+    REQUIRE(r::match("/b").index == 0);
+    REQUIRE(r::match("/b").suffix == "/b");
+    REQUIRE(r::match("/ab").index == 1);
+  }
+
+  SECTION("agrees with a linear scan")
+  {
+    // every prefix of every route, with and without a mismatching byte appended
+    for (auto i = 0u; i < api::size(); ++i) {
+      auto const route = std::string{ api::route(i) };
+      for (auto len = 0u; len <= route.size(); ++len) {
+        for (auto tail : { ""sv, "x"sv, "/"sv, "v2/orders/"sv }) {
+          auto const path = route.substr(0, len) + std::string{ tail };
+          auto const m = api::match(path);
+          auto const expected = naive<api>(path);
+          REQUIRE(m.index == expected.index);
+          REQUIRE(m.suffix == expected.suffix);
+        }
+      }
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,116 @@
+#include <catch2/catch.hpp>
+
+#include <version>
+
+#ifdef MTP_USE_STD_MODULE
+import std;
+#else
+#  include <string>
+#  include <string_view>
+#  include <vector>
+#endif
+
+#ifdef MTP_BUILD_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/splitter.hpp>
+#endif
+
+#if __cpp_nontype_template_args >= 201911L // class type NTTPs
+
+namespace {
+
+template <typename Splitter>
+auto
+split(std::string_view str) -> std::vector<std::string>
+{
+  std::vector<std::string> out;
+  for (auto token : Splitter::split(str)) {
+    out.emplace_back(token);
+  }
+  return out;
+}
+
+template <typename Splitter>
+auto
+split_chunked(std::string_view str, std::size_t chunk) -> std::vector<std::string>
+{
+  std::vector<std::string> out;
+  auto emit = [&](std::string_view token) { out.emplace_back(token); };
+  typename Splitter::stream s;
+  for (std::size_t i = 0; i < str.size(); i += chunk) {
+    s.feed(str.substr(i, chunk), emit);
+  }
+  s.finish(emit);
+  return out;
+}
+
+using strs = std::vector<std::string>;
+
+} // namespace
+
+TEST_CASE("splitter", "[splitter]")
+{
+  using csv = mtp::splitter<",;=">;
+
+  SECTION("classification")
+  {
+    static_assert(csv::is_delimiter(',') && csv::is_delimiter(';') && csv::is_delimiter('='));
+    static_assert(not csv::is_delimiter('a') && not csv::is_delimiter('\0'));
+  }
+
+  SECTION("tokens")
+  {
+    CHECK(split<csv>("").empty());
+    CHECK(split<csv>("a") == strs{ "a" });
+    CHECK(split<csv>("a,b;c=d") == strs{ "a", "b", "c", "d" });
+    CHECK(split<csv>(",a,,b,") == strs{ "", "a", "", "b", "" });
+  }
+
+  SECTION("long input crosses vector blocks")
+  {
+    auto const line = std::string{ "symbol=AAPL;qty=100;px=187.25,venue=XNAS;side=buy,"
+                                   "account=0123456789abcdef;tag=" };
+    auto const tokens = split<csv>(line);
+    CHECK(tokens == strs{ "symbol", "AAPL", "qty", "100", "px", "187.25", "venue", "XNAS", "side",
+                          "buy", "account", "0123456789abcdef", "tag", "" });
+  }
+
+  SECTION("bytes sharing a low nibble")
+  {
+    // ',' is 0x2C and 'L' is 0x4C; 'l' (0x6C) must not match
+    using s = mtp::splitter<",L">;
+    CHECK(split<s>("alpha,BETA,GAMMALLAMBDA-lowercase-l-free-text")
+          == strs{ "alpha", "BETA", "GAMMA", "", "AMBDA-lowercase-l-free-text" });
+  }
+
+  SECTION("many high nibbles")
+  {
+    // more than 8 distinct high nibbles falls back to compare-per-byte
+    using s = mtp::splitter<"\x01\x11!1AQaq\x81\x91">;
+    CHECK(split<s>("xx!yyyyyyyyyyyyyyyyyyyyyyyyyyAzzzzzzzzqw") ==
+          strs{ "xx", "yyyyyyyyyyyyyyyyyyyyyyyyyy", "zzzzzzzz", "w" });
+  }
+
+  SECTION("quoting")
+  {
+    using quoted = mtp::splitter<",", '"'>;
+    CHECK(split<quoted>(R"(a,"b,c",d)") == strs{ "a", R"("b,c")", "d" });
+    CHECK(split<quoted>(R"("he said ""hi, there""",x)") ==
+          strs{ R"("he said ""hi, there""")", "x" });
+    CHECK(split<csv>(R"(a,"b,c")") == strs{ "a", "\"b", "c\"" });
+  }
+
+  SECTION("streaming")
+  {
+    auto const line = std::string{ R"(id=1,"name=x,y",,price=10.5;qty=7,)" };
+    using quoted = mtp::splitter<",;=", '"'>;
+    auto const expected = split<quoted>(line);
+    for (std::size_t chunk = 1; chunk <= line.size(); ++chunk) {
+      REQUIRE(split_chunked<quoted>(line, chunk) == expected);
+    }
+    CHECK(split_chunked<quoted>("", 4).empty());
+  }
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef MTP_TEST_SUPPORT_RANDOM_KEYS_HPP
+#define MTP_TEST_SUPPORT_RANDOM_KEYS_HPP
+
+// Deterministic pseudo-random fixed-length keys for the tests and the benchmarks, which both have
+// this directory on their include path.
+
+#ifndef MTP_USE_STD_MODULE
+#  include <cstddef>
+#  include <cstdint>
+#  include <vector>
+#endif
+
+namespace random_keys {
+
+// xorshift64
+struct xorshift
+{
+  std::uint64_t state = 88172645463325252u;
+
+  constexpr auto
+  operator()() noexcept -> std::uint64_t
+  {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+};
+
+// `n` keys of the `basic_fixed_string` type `Key`, every character chosen by `pick(random)`
+template <typename Key, typename Pick>
+auto
+make(std::size_t n, Pick pick) -> std::vector<Key>
+{
+  using char_type = typename Key::value_type;
+  constexpr std::size_t len = Key::size();
+
+  std::vector<Key> keys;
+  keys.reserve(n);
+  xorshift rng;
+  char_type buf[len + 1]{};
+  for (std::size_t k = 0; k < n; ++k) {
+    for (std::size_t i = 0; i < len; ++i) {
+      buf[i] = static_cast<char_type>(pick(rng()));
+    }
+    keys.emplace_back(buf, buf + len);
+  }
+  return keys;
+}
+
+} // namespace random_keys
+
+#endif // MTP_TEST_SUPPORT_RANDOM_KEYS_HPP
@@ -0,0 +1,53 @@
+// Decodes a binary log written by mtp::log_backend into text, one record per line:
+//
+//   mtp_log_decode [file]    (standard input when no file is given)
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string_view>
+#include <system_error>
+
+#ifdef MTP_BUILD_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/log.hpp>
+#endif
+
+auto
+main(int argc, char** argv) -> int
+{
+  if (argc > 2) {
+    std::fprintf(stderr, "usage: %s [file]\n", argv[0]);
+    return 2;
+  }
+  auto* in = argc == 2 ? std::fopen(argv[1], "rb") : stdin;
+  if (in == nullptr) {
+    std::perror(argv[1]);
+    return 2;
+  }
+
+  mtp::log_decoder decoder;
+  std::byte buf[1 << 16];
+  std::errc ec{};
+  auto print = [](std::uint32_t thread, std::string_view line) {
+    std::printf("[%u] %.*s\n", thread, static_cast<int>(line.size()), line.data());
+  };
+  for (std::size_t n; ec == std::errc{} && (n = std::fread(buf, 1, sizeof(buf), in)) != 0;) {
+    decoder.feed(std::span<std::byte const>{ buf, n }, print, ec);
+  }
+  if (in != stdin) {
+    std::fclose(in);
+  }
+
+  if (ec != std::errc{}) {
+    std::fprintf(stderr, "malformed log\n");
+    return 1;
+  }
+  if (!decoder.complete()) {
+    std::fprintf(stderr, "log ends in the middle of a record\n");
+    return 1;
+  }
+  return 0;
+}